@@ -70,6 +70,9 @@ configManager = {}
 ---@field getMonsterCount fun(): number
 ---@field getPlayerCount fun(): number
 ---@field getNpcCount fun(): number
+---@field getConnectionDrops fun(reason: number): number
+---@field getOutputMessagePoolStats fun(): table
+---@field getAutosendLatencyStats fun(): table
 ---@field getMonsterTypes fun(): table
 ---@field getBestiary fun(): table
 ---@field getCurrencyItems fun(): table
@@ -336,6 +339,8 @@ Podium = {}
 ---@field removeIcon fun(self: Creature)
 ---@field getStorageValue fun(self: Creature, key: number): any
 ---@field setStorageValue fun(self: Creature, key: number, value: any)
+---@field getStorageValues fun(self: Creature, keys: number[]): table<number, number>
+---@field setStorageValues fun(self: Creature, values: table<number, number|false>): boolean
 Creature = {}
 
 ---@class Player : Creature
@@ -1530,6 +1535,7 @@ TILESTATE_IMMOVABLEBLOCKPATH = 1 * 2 ^ 20
 TILESTATE_IMMOVABLENOFIELDBLOCKPATH = 1 * 2 ^ 21
 TILESTATE_NOFIELDBLOCKPATH = 1 * 2 ^ 22
 TILESTATE_SUPPORTS_HANGABLE = 1 * 2 ^ 23
+TILESTATE_BLOCKPROJECTILE = 1 * 2 ^ 24
 
 TILESTATE_FLOORCHANGE =
 	TILESTATE_FLOORCHANGE_DOWN or TILESTATE_FLOORCHANGE_NORTH or
@@ -2400,3 +2406,9 @@ SPELLGROUP_ULTIMATESTRIKES = 8
 WORLD_TYPE_NO_PVP = 1
 WORLD_TYPE_PVP = 2
 WORLD_TYPE_PVP_ENFORCED = 3
+
+CONNECTION_DROP_CONNECTION_RATE = 0
+CONNECTION_DROP_STATUS_RATE = 1
+CONNECTION_DROP_PACKET_RATE = 2
+CONNECTION_DROP_LOGIN_RATE = 3
+CONNECTION_DROP_LOGIN_BACKLOG = 4
@@ -23,21 +23,42 @@ std::vector<Tile*> getList(const MatrixArea& area, const Position& targetPos, co
 
 	auto center = area.getCenter();
 
-	Position tmpPos(targetPos.x - center.first, targetPos.y - center.second, targetPos.z);
-	for (uint32_t row = 0; row < area.getRows(); ++row, ++tmpPos.y) {
-		for (uint32_t col = 0; col < area.getCols(); ++col, ++tmpPos.x) {
-			if (area(row, col)) {
-				if (g_game.isSightClear(casterPos, tmpPos, true)) {
-					Tile* tile = g_game.map.getTile(tmpPos);
-					if (!tile) {
-						tile = new StaticTile(tmpPos.x, tmpPos.y, tmpPos.z);
-						g_game.map.setTile(tmpPos, tile);
-					}
-					vec.push_back(tile);
+	// neighbouring cells share their floor block, so only descend the quadtree when the area crosses into another one
+	const Floor* floor = nullptr;
+	int32_t blockX = -1;
+	int32_t blockY = -1;
+
+	const Position origin(targetPos.x - center.first, targetPos.y - center.second, targetPos.z);
+	Position tmpPos = origin;
+	for (uint32_t row = 0; row < area.getRows(); ++row) {
+		tmpPos.y = origin.y + row;
+		for (uint32_t word = 0; word < area.getRowWords(); ++word) {
+			// visit only the set cells of the row, lowest column first
+			for (uint64_t mask = area.getRowMask(row, word); mask != 0; mask &= mask - 1) {
+				tmpPos.x = origin.x + word * 64 + std::countr_zero(mask);
+				if (!g_game.isSightClear(casterPos, tmpPos, true)) {
+					continue;
+				}
+
+				if ((tmpPos.x & ~FLOOR_MASK) != blockX || (tmpPos.y & ~FLOOR_MASK) != blockY) {
+					blockX = tmpPos.x & ~FLOOR_MASK;
+					blockY = tmpPos.y & ~FLOOR_MASK;
+
+					const QTreeLeafNode* leaf = g_game.map.getQTNode(tmpPos.x, tmpPos.y);
+					floor = (leaf && tmpPos.z < MAP_MAX_LAYERS) ? leaf->getFloor(tmpPos.z) : nullptr;
 				}
+
+				Tile* tile = floor ? floor->tiles[tmpPos.x & FLOOR_MASK][tmpPos.y & FLOOR_MASK] : nullptr;
+				if (!tile) {
+					tile = new StaticTile(tmpPos.x, tmpPos.y, tmpPos.z);
+					g_game.map.setTile(tmpPos, tile);
+
+					// the leaf or floor block may have just been created
+					blockX = blockY = -1;
+				}
+				vec.push_back(tile);
 			}
 		}
-		tmpPos.x -= area.getCols();
 	}
 	return vec;
 }
@@ -1257,6 +1278,10 @@ void AreaCombat::setupArea(const std::vector<uint32_t>& vec, uint32_t rows)
 	areas[DIRECTION_SOUTH] = area.rotate180();
 	areas[DIRECTION_WEST] = area.rotate270();
 	areas[DIRECTION_NORTH] = std::move(area);
+
+	for (auto dir : {DIRECTION_NORTH, DIRECTION_EAST, DIRECTION_SOUTH, DIRECTION_WEST}) {
+		areas[dir].compileRowMasks();
+	}
 }
 
 void AreaCombat::setupArea(int32_t length, int32_t spread)
@@ -1361,6 +1386,10 @@ void AreaCombat::setupExtArea(const std::vector<uint32_t>& vec, uint32_t rows)
 	areas[DIRECTION_SOUTHEAST] = area.rotate180();
 	areas[DIRECTION_SOUTHWEST] = area.rotate270();
 	areas[DIRECTION_NORTHWEST] = std::move(area);
+
+	for (auto dir : {DIRECTION_NORTHWEST, DIRECTION_NORTHEAST, DIRECTION_SOUTHWEST, DIRECTION_SOUTHEAST}) {
+		areas[dir].compileRowMasks();
+	}
 }
 
 //**********************************************************//
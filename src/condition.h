@@ -271,6 +271,8 @@ public:
 	int32_t getTotalDamage() const;
 
 	void setInitDamage(int32_t initDamage) { this->initDamage = initDamage; }
+	int32_t getInitDamage() const { return initDamage; }
+	const std::list<IntervalInfo>& getDamageList() const { return damageList; }
 
 	// serialization
 	void serialize(PropWriteStream& propWriteStream) override;
@@ -302,6 +302,8 @@ bool ConfigManager::load()
 	integer[STAMINA_REGEN_PREMIUM] = getGlobalNumber(L, "timeToRegenMinutePremiumStamina", 6 * 60);
 	integer[PATHFINDING_INTERVAL] = getGlobalNumber(L, "pathfindingInterval", 200);
 	integer[PATHFINDING_DELAY] = getGlobalNumber(L, "pathfindingDelay", 300);
+	integer[STATUS_CACHE_TIME] = getGlobalNumber(L, "statusCacheTime", 5000);
+	integer[AUTOSEND_COALESCE_TIME] = getGlobalNumber(L, "autosendCoalesceTime", 0);
 
 	expStages = loadXMLStages();
 	if (expStages.empty()) {
@@ -123,6 +123,8 @@ enum integer_config_t
 	STAMINA_REGEN_PREMIUM,
 	PATHFINDING_INTERVAL,
 	PATHFINDING_DELAY,
+	STATUS_CACHE_TIME,
+	AUTOSEND_COALESCE_TIME,
 
 	LAST_INTEGER_CONFIG /* this must be the last one */
 };
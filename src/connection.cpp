@@ -8,6 +8,7 @@
 #include "configmanager.h"
 #include "outputmessage.h"
 #include "protocol.h"
+#include "ratelimit.h"
 #include "server.h"
 #include "tasks.h"
 
@@ -148,6 +149,7 @@ void Connection::parseHeader(const boost::system::error_code& error)
 	uint32_t timePassed = std::max<uint32_t>(1, (time(nullptr) - timeConnected) + 1);
 	if ((++packetsSent / timePassed) > static_cast<uint32_t>(getNumber(ConfigManager::MAX_PACKETS_PER_SECOND))) {
 		std::cout << getIP() << " disconnected for exceeding packet per second limit." << std::endl;
+		addConnectionDrop(CONNECTION_DROP_PACKET_RATE);
 		close();
 		return;
 	}
@@ -242,6 +244,31 @@ void Connection::parsePacket(const boost::system::error_code& error)
 		protocol->onRecvMessage(msg); // Send the packet to the current protocol
 	}
 
+	if (!readPaused) {
+		readNextPacket();
+	}
+}
+
+void Connection::resumeRead(std::function<void()> handler)
+{
+	// any thread
+	boost::asio::post(socket.get_executor(), [thisPtr = shared_from_this(), handler = std::move(handler)]() {
+		std::lock_guard<std::recursive_mutex> lockClass(thisPtr->connectionLock);
+		if (thisPtr->connectionState == CONNECTION_STATE_DISCONNECTED) {
+			return;
+		}
+
+		thisPtr->readPaused = false;
+		handler();
+
+		if (!thisPtr->readPaused && thisPtr->connectionState != CONNECTION_STATE_DISCONNECTED) {
+			thisPtr->readNextPacket();
+		}
+	});
+}
+
+void Connection::readNextPacket()
+{
 	try {
 		readTimer.expires_after(std::chrono::seconds(CONNECTION_READ_TIMEOUT));
 		readTimer.async_wait(
@@ -256,7 +283,7 @@ void Connection::parsePacket(const boost::system::error_code& error)
 			    thisPtr->parseHeader(error);
 		    });
 	} catch (boost::system::system_error& e) {
-		std::cout << "[Network error - Connection::parsePacket] " << e.what() << std::endl;
+		std::cout << "[Network error - Connection::readNextPacket] " << e.what() << std::endl;
 		close(FORCE_CLOSE);
 	}
 }
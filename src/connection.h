@@ -83,11 +83,17 @@ public:
 
 	void send(const OutputMessage_ptr& msg);
 
+	// Used by protocols that finish handling a packet on another thread: no further packet is read after the current
+	// one until resumeRead, which runs the handler on the network thread first, and the message is left untouched
+	void pauseRead() { readPaused = true; }
+	void resumeRead(std::function<void()> handler);
+
 	const Address& getIP() const { return remoteAddress; };
 
 private:
 	void parseHeader(const boost::system::error_code& error);
 	void parsePacket(const boost::system::error_code& error);
+	void readNextPacket();
 
 	void onWriteOperation(const boost::system::error_code& error);
 
@@ -118,6 +124,7 @@ private:
 
 	ConnectionState_t connectionState = CONNECTION_STATE_PENDING;
 	bool receivedFirst = false;
+	bool readPaused = false;
 	bool receivedName = false;
 	bool receivedLastChar = false;
 };
@@ -375,7 +375,6 @@ public:
 
 	virtual void setStorageValue(uint32_t key, std::optional<int32_t> value, bool isSpawn = false);
 	virtual std::optional<int32_t> getStorageValue(uint32_t key) const;
-	decltype(auto) getStorageMap() const { return storageMap; }
 
 protected:
 	struct CountBlock_t
@@ -465,7 +464,7 @@ protected:
 	friend class LuaScriptInterface;
 
 private:
-	std::map<uint32_t, int32_t> storageMap;
+	std::unordered_map<uint32_t, int32_t> storageMap;
 };
 
 #endif // FS_CREATURE_H
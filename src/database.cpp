@@ -221,7 +221,10 @@ bool DBResult::next()
 	return row;
 }
 
-DBInsert::DBInsert(std::string query) : query(std::move(query)) { this->length = this->query.length(); }
+DBInsert::DBInsert(std::string query, std::string suffix) : query(std::move(query)), suffix(std::move(suffix))
+{
+	this->length = this->query.length() + this->suffix.length();
+}
 
 bool DBInsert::addRow(const std::string& row)
 {
@@ -261,8 +264,8 @@ bool DBInsert::execute()
 	}
 
 	// executes buffer
-	bool res = Database::getInstance().executeQuery(query + values);
+	bool res = Database::getInstance().executeQuery(query + values + suffix);
 	values.clear();
-	length = query.length();
+	length = query.length() + suffix.length();
 	return res;
 }
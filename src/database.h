@@ -169,13 +169,14 @@ private:
 class DBInsert
 {
 public:
-	explicit DBInsert(std::string query);
+	explicit DBInsert(std::string query, std::string suffix = {});
 	bool addRow(const std::string& row);
 	bool addRow(std::ostringstream& row);
 	bool execute();
 
 private:
 	std::string query;
+	std::string suffix;
 	std::string values;
 	size_t length;
 };
@@ -94,14 +94,22 @@ bool Loader::getProps(const Node& node, PropStream& props)
 	if (size == 0) {
 		return false;
 	}
+
+	// most nodes contain no escaped bytes, those are read straight from the mapped file
+	auto firstEscape = std::find(node.propsBegin, node.propsEnd, static_cast<char>(Node::ESCAPE));
+	if (firstEscape == node.propsEnd) {
+		props.init(&*node.propsBegin, size);
+		return true;
+	}
+
 	propBuffer.resize(size);
 	bool lastEscaped = false;
 
-	auto escapedPropEnd =
-	    std::copy_if(node.propsBegin, node.propsEnd, propBuffer.begin(), [&lastEscaped](const char& byte) {
-		    lastEscaped = byte == static_cast<char>(Node::ESCAPE) && !lastEscaped;
-		    return !lastEscaped;
-	    });
+	auto escapedPropEnd = std::copy(node.propsBegin, firstEscape, propBuffer.begin());
+	escapedPropEnd = std::copy_if(firstEscape, node.propsEnd, escapedPropEnd, [&lastEscaped](const char& byte) {
+		lastEscaped = byte == static_cast<char>(Node::ESCAPE) && !lastEscaped;
+		return !lastEscaped;
+	});
 	props.init(&propBuffer[0], std::distance(propBuffer.begin(), escapedPropEnd));
 	return true;
 }
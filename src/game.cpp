@@ -397,17 +397,12 @@ Creature* Game::getCreatureByName(const std::string& s)
 		return nullptr;
 	}
 
-	const std::string& lowerCaseName = boost::algorithm::to_lower_copy(s);
-
-	if (auto it = mappedPlayerNames.find(lowerCaseName); it != mappedPlayerNames.end()) {
+	if (auto it = mappedPlayerNames.find(s); it != mappedPlayerNames.end()) {
 		return it->second;
 	}
 
 	auto equalCreatureName = [&](const std::pair<uint32_t, Creature*>& it) {
-		auto name = it.second->getName();
-		return lowerCaseName.size() == name.size() &&
-		       std::equal(lowerCaseName.begin(), lowerCaseName.end(), name.begin(),
-		                  [](char a, char b) { return a == std::tolower(b); });
+		return caseInsensitiveEqual(s, it.second->getName());
 	};
 
 	if (auto it = std::find_if(npcs.begin(), npcs.end(), equalCreatureName); it != npcs.end()) {
@@ -442,7 +437,7 @@ Player* Game::getPlayerByName(const std::string& s)
 		return nullptr;
 	}
 
-	auto it = mappedPlayerNames.find(boost::algorithm::to_lower_copy(s));
+	auto it = mappedPlayerNames.find(s);
 	if (it == mappedPlayerNames.end()) {
 		return nullptr;
 	}
@@ -1425,9 +1420,6 @@ ReturnValue Game::internalRemoveItem(Item* item, int32_t count /*= -1*/, bool te
 
 		if (item->isRemoved()) {
 			item->onRemoved();
-			if (item->canDecay()) {
-				decayItems->remove(item);
-			}
 			ReleaseItem(item);
 		}
 
@@ -3879,20 +3871,23 @@ void Game::checkCreatures(size_t index)
 	g_scheduler.addEvent(createSchedulerTask(EVENT_CHECK_CREATURE_INTERVAL,
 	                                         [=, this]() { checkCreatures((index + 1) % EVENT_CREATURECOUNT); }));
 
+	// creatures may be appended to this bucket while thinking, so iterate by index
 	auto& checkCreatureList = checkCreatureLists[index];
-	auto it = checkCreatureList.begin(), end = checkCreatureList.end();
-	while (it != end) {
-		Creature* creature = *it;
+	size_t i = 0;
+	while (i < checkCreatureList.size()) {
+		Creature* creature = checkCreatureList[i];
 		if (creature->creatureCheck) {
 			if (!creature->isDead()) {
 				creature->onThink(EVENT_CREATURE_THINK_INTERVAL);
 				creature->onAttacking(EVENT_CREATURE_THINK_INTERVAL);
 				creature->executeConditions(EVENT_CREATURE_THINK_INTERVAL);
 			}
-			++it;
+			++i;
 		} else {
 			creature->inCheckCreaturesVector = false;
-			it = checkCreatureList.erase(it);
+			// the order inside a bucket does not matter, swap with the last entry instead of shifting
+			checkCreatureList[i] = checkCreatureList.back();
+			checkCreatureList.pop_back();
 			ReleaseCreature(creature);
 		}
 	}
@@ -4784,13 +4779,19 @@ void Game::checkDecay()
 	g_scheduler.addEvent(createSchedulerTask(EVENT_DECAYINTERVAL, [this]() { checkDecay(); }));
 	size_t bucket = (lastBucket + 1) % EVENT_DECAY_BUCKETS;
 
-	auto it = decayItems[bucket].begin(), end = decayItems[bucket].end();
-	while (it != end) {
-		Item* item = *it;
+	auto& decayList = decayItems[bucket];
+	auto eraseItem = [&decayList](size_t i) {
+		decayList[i] = decayList.back();
+		decayList.pop_back();
+	};
+
+	size_t i = 0;
+	while (i < decayList.size()) {
+		Item* item = decayList[i];
 		if (!item->canDecay()) {
 			item->setDecaying(DECAYING_FALSE);
 			ReleaseItem(item);
-			it = decayItems[bucket].erase(it);
+			eraseItem(i);
 			continue;
 		}
 
@@ -4801,11 +4802,11 @@ void Game::checkDecay()
 		item->decreaseDuration(decreaseTime);
 
 		if (duration <= 0) {
-			it = decayItems[bucket].erase(it);
+			eraseItem(i);
 			internalDecayItem(item);
 			ReleaseItem(item);
 		} else if (duration < EVENT_DECAYINTERVAL * EVENT_DECAY_BUCKETS) {
-			it = decayItems[bucket].erase(it);
+			eraseItem(i);
 			size_t newBucket = (bucket + ((duration + EVENT_DECAYINTERVAL / 2) / 1000)) % EVENT_DECAY_BUCKETS;
 			if (newBucket == bucket) {
 				internalDecayItem(item);
@@ -4814,7 +4815,7 @@ void Game::checkDecay()
 				decayItems[newBucket].push_back(item);
 			}
 		} else {
-			++it;
+			++i;
 		}
 	}
 
@@ -506,13 +506,13 @@ private:
 	void internalDecayItem(Item* item);
 
 	std::unordered_map<uint32_t, Player*> players;
-	std::unordered_map<std::string, Player*> mappedPlayerNames;
+	std::unordered_map<std::string, Player*, CaseInsensitiveHash, CaseInsensitiveEqual> mappedPlayerNames;
 	std::unordered_map<uint32_t, Player*> mappedPlayerGuids;
 	std::unordered_map<uint32_t, Guild_ptr> guilds;
 	std::unordered_map<uint16_t, Item*> uniqueItems;
 
-	std::list<Item*> decayItems[EVENT_DECAY_BUCKETS];
-	std::list<Creature*> checkCreatureLists[EVENT_CREATURECOUNT];
+	std::vector<Item*> decayItems[EVENT_DECAY_BUCKETS];
+	std::vector<Creature*> checkCreatureLists[EVENT_CREATURECOUNT];
 
 	std::vector<Creature*> ToReleaseCreatures;
 	std::vector<Item*> ToReleaseItems;
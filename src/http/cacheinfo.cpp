@@ -2,20 +2,39 @@
 
 #include "cacheinfo.h"
 
+#include "../configmanager.h"
 #include "../database.h"
+#include "../tools.h"
 #include "error.h"
+#include "worker.h"
 
 namespace beast = boost::beast;
 namespace json = boost::json;
 using boost::beast::http::status;
 
+namespace {
+
+// the online count is shared by all workers and only queried again once statusCacheTime has passed
+std::mutex playersOnlineLock;
+uint32_t playersOnline = 0;
+int64_t playersOnlineUpdatedAt = 0;
+
+} // namespace
+
 std::pair<status, json::value> tfs::http::handle_cacheinfo(const json::object&, std::string_view)
 {
-	thread_local auto& db = Database::getInstance();
+	std::lock_guard<std::mutex> lockGuard(playersOnlineLock);
+	if (OTSYS_TIME() < playersOnlineUpdatedAt + getNumber(ConfigManager::STATUS_CACHE_TIME)) {
+		return {status::ok, {{"playersonline", playersOnline}}};
+	}
+
+	auto& db = get_database();
 	auto result = db.storeQuery("SELECT COUNT(*) AS `count` FROM `players_online`");
 	if (!result) {
 		return make_error_response();
 	}
 
-	return {status::ok, {{"playersonline", result->getNumber<uint32_t>("count")}}};
+	playersOnline = result->getNumber<uint32_t>("count");
+	playersOnlineUpdatedAt = OTSYS_TIME();
+	return {status::ok, {{"playersonline", playersOnline}}};
 }
@@ -3,6 +3,7 @@
 #include "http.h"
 
 #include "listener.h"
+#include "worker.h"
 
 #include <fmt/core.h>
 #include <thread>
@@ -34,7 +35,7 @@ void tfs::http::start(bool bindOnlyOtsIP, std::string_view otsIP, unsigned short
 
 	workers.reserve(threads);
 	for (auto i = 0; i < threads; ++i) {
-		workers.emplace_back([] { ioc.run(); });
+		workers.emplace_back([] { run_worker(ioc); });
 	}
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string_view>
 
 namespace tfs::http {
@@ -7,4 +8,7 @@ namespace tfs::http {
 void start(bool bindOnlyOtsIP, std::string_view otsIP, unsigned short port = 8080, int threads = 1);
 void stop();
 
+// drops the cached character list of an account, called whenever one of its characters is saved
+void invalidate_characters(uint64_t accountId);
+
 } // namespace tfs::http
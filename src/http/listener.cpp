@@ -1,5 +1,6 @@
 #include "listener.h"
 
+#include "../ratelimit.h"
 #include "session.h"
 
 #include <boost/asio/strand.hpp>
@@ -8,6 +9,8 @@
 namespace asio = boost::asio;
 namespace beast = boost::beast;
 
+extern RateLimiter g_connectionLimiter;
+
 namespace tfs::http {
 
 Listener::Listener(asio::io_context& ioc, asio::ip::tcp::acceptor&& acceptor) : ioc{ioc}, acceptor{std::move(acceptor)}
@@ -29,6 +32,16 @@ void Listener::on_accept(beast::error_code ec, asio::ip::tcp::socket socket)
 		return;
 	}
 
+	beast::error_code endpointError;
+	if (auto endpoint = socket.remote_endpoint(endpointError);
+	    !endpointError &&
+	    !g_connectionLimiter.consume(endpoint.address(), CONNECTION_RATE_INTERVAL, CONNECTION_RATE_BURST)) {
+		addConnectionDrop(CONNECTION_DROP_CONNECTION_RATE);
+		socket.close(endpointError);
+		accept();
+		return;
+	}
+
 	// Create the session and run it
 	auto session = make_session(std::move(socket));
 	session->run();
@@ -5,6 +5,8 @@
 #include "../base64.h"
 #include "../game.h"
 #include "error.h"
+#include "http.h"
+#include "worker.h"
 
 #include <fmt/format.h>
 
@@ -31,8 +33,93 @@ int getPvpType()
 	std::unreachable();
 }
 
+// logins of an account come in bursts (client retries, switching characters), so its character list is kept for a
+// short while instead of being selected again on every login
+constexpr int64_t CHARACTERS_CACHE_TIME = 10 * 1000;
+constexpr size_t CHARACTERS_CACHE_SIZE = 4096;
+
+struct CharacterList
+{
+	int64_t expiresAt;
+	uint32_t lastLogin = 0;
+	json::array characters;
+};
+
+std::mutex charactersLock;
+std::unordered_map<uint64_t, std::shared_ptr<const CharacterList>> charactersCache;
+// changes with every invalidation, so that a list selected before a save is not cached after it
+uint64_t charactersGeneration = 0;
+
+std::shared_ptr<const CharacterList> loadCharacters(Database& db, uint64_t accountId)
+{
+	uint64_t generation;
+	{
+		std::lock_guard<std::mutex> lockGuard(charactersLock);
+		auto it = charactersCache.find(accountId);
+		if (it != charactersCache.end() && OTSYS_TIME() < it->second->expiresAt) {
+			return it->second;
+		}
+		generation = charactersGeneration;
+	}
+
+	auto characterList = std::make_shared<CharacterList>();
+
+	auto result = db.storeQuery(fmt::format(
+	    "SELECT `id`, `name`, `level`, `vocation`, `lastlogin`, `sex`, `looktype`, `lookhead`, `lookbody`, `looklegs`, `lookfeet`, `lookaddons` FROM `players` WHERE `account_id` = {:d}",
+	    accountId));
+	if (result) {
+		do {
+			auto vocation = g_vocations.getVocation(result->getNumber<uint32_t>("vocation"));
+			assert(vocation);
+
+			characterList->characters.push_back({
+			    {"worldid", 0}, // not implemented
+			    {"name", result->getString("name")},
+			    {"level", result->getNumber<uint32_t>("level")},
+			    {"vocation", vocation->getVocName()},
+			    {"lastlogin", result->getNumber<uint64_t>("lastlogin")},
+			    {"ismale", result->getNumber<uint16_t>("sex") == PLAYERSEX_MALE},
+			    {"ishidden", false},        // not implemented
+			    {"ismaincharacter", false}, // not implemented
+			    {"tutorial", false},        // not implemented
+			    {"outfitid", result->getNumber<uint32_t>("looktype")},
+			    {"headcolor", result->getNumber<uint32_t>("lookhead")},
+			    {"torsocolor", result->getNumber<uint32_t>("lookbody")},
+			    {"legscolor", result->getNumber<uint32_t>("looklegs")},
+			    {"detailcolor", result->getNumber<uint32_t>("lookfeet")},
+			    {"addonsflags", result->getNumber<uint32_t>("lookaddons")},
+			    {"dailyrewardstate", 0}, // not implemented
+			});
+
+			characterList->lastLogin = std::max(characterList->lastLogin, result->getNumber<uint32_t>("lastlogin"));
+		} while (result->next());
+	}
+
+	int64_t now = OTSYS_TIME();
+	characterList->expiresAt = now + CHARACTERS_CACHE_TIME;
+
+	std::lock_guard<std::mutex> lockGuard(charactersLock);
+	if (generation == charactersGeneration) {
+		if (charactersCache.size() >= CHARACTERS_CACHE_SIZE) {
+			std::erase_if(charactersCache, [now](const auto& it) { return it.second->expiresAt <= now; });
+		}
+
+		if (charactersCache.size() < CHARACTERS_CACHE_SIZE) {
+			charactersCache.insert_or_assign(accountId, characterList);
+		}
+	}
+	return characterList;
+}
+
 } // namespace
 
+void tfs::http::invalidate_characters(uint64_t accountId)
+{
+	std::lock_guard<std::mutex> lockGuard(charactersLock);
+	charactersCache.erase(accountId);
+	++charactersGeneration;
+}
+
 std::pair<status, json::value> tfs::http::handle_login(const json::object& body, std::string_view ip)
 {
 	using namespace std::chrono;
@@ -49,7 +136,7 @@ std::pair<status, json::value> tfs::http::handle_login(const json::object& body,
 		    {.code = 3, .message = "Tibia account email address or Tibia password is not correct."});
 	}
 
-	thread_local auto& db = Database::getInstance();
+	auto& db = get_database();
 	auto result = db.storeQuery(fmt::format(
 	    "SELECT `id`, UNHEX(`password`) AS `password`, `secret`, `premium_ends_at` FROM `accounts` WHERE `email` = {:s}",
 	    db.escapeString(emailField->get_string())));
@@ -91,39 +178,7 @@ std::pair<status, json::value> tfs::http::handle_login(const json::object& body,
 		return make_error_response();
 	}
 
-	result = db.storeQuery(fmt::format(
-	    "SELECT `id`, `name`, `level`, `vocation`, `lastlogin`, `sex`, `looktype`, `lookhead`, `lookbody`, `looklegs`, `lookfeet`, `lookaddons` FROM `players` WHERE `account_id` = {:d}",
-	    accountId));
-
-	json::array characters;
-	uint32_t lastLogin = 0;
-	if (result) {
-		do {
-			auto vocation = g_vocations.getVocation(result->getNumber<uint32_t>("vocation"));
-			assert(vocation);
-
-			characters.push_back({
-			    {"worldid", 0}, // not implemented
-			    {"name", result->getString("name")},
-			    {"level", result->getNumber<uint32_t>("level")},
-			    {"vocation", vocation->getVocName()},
-			    {"lastlogin", result->getNumber<uint64_t>("lastlogin")},
-			    {"ismale", result->getNumber<uint16_t>("sex") == PLAYERSEX_MALE},
-			    {"ishidden", false},        // not implemented
-			    {"ismaincharacter", false}, // not implemented
-			    {"tutorial", false},        // not implemented
-			    {"outfitid", result->getNumber<uint32_t>("looktype")},
-			    {"headcolor", result->getNumber<uint32_t>("lookhead")},
-			    {"torsocolor", result->getNumber<uint32_t>("lookbody")},
-			    {"legscolor", result->getNumber<uint32_t>("looklegs")},
-			    {"detailcolor", result->getNumber<uint32_t>("lookfeet")},
-			    {"addonsflags", result->getNumber<uint32_t>("lookaddons")},
-			    {"dailyrewardstate", 0}, // not implemented
-			});
-
-			lastLogin = std::max(lastLogin, result->getNumber<uint32_t>("lastlogin"));
-		} while (result->next());
-	}
+	auto characterList = loadCharacters(db, accountId);
 
 	json::array worlds{
 	    {
@@ -146,7 +201,7 @@ std::pair<status, json::value> tfs::http::handle_login(const json::object& body,
 	        {"session",
 	         {
 	             {"sessionkey", tfs::base64::encode(sessionKey)},
-	             {"lastlogintime", lastLogin},
+	             {"lastlogintime", characterList->lastLogin},
 	             {"ispremium", premiumEndsAt >= now},
 	             {"premiumuntil", premiumEndsAt},
 	             // not implemented
@@ -161,7 +216,7 @@ std::pair<status, json::value> tfs::http::handle_login(const json::object& body,
 	        {"playdata",
 	         {
 	             {"worlds", worlds},
-	             {"characters", characters},
+	             {"characters", characterList->characters},
 	         }},
 	    },
 	};
@@ -26,6 +26,8 @@ struct CacheInfoFixture
 
 	~CacheInfoFixture()
 	{
+		setNumber(ConfigManager::STATUS_CACHE_TIME, statusCacheTime);
+
 		// `players_online` is a memory table and does not support transactions, so we need to clear it manually
 		// do NOT run this test against a running server's database
 		db.executeQuery("TRUNCATE `players_online`");
@@ -34,6 +36,9 @@ struct CacheInfoFixture
 	Database& db = Database::getInstance();
 	DBTransaction transaction;
 
+	// tests that change the cache time get it restored here
+	int32_t statusCacheTime = getNumber(ConfigManager::STATUS_CACHE_TIME);
+
 	std::string_view ip = "74.125.224.72";
 	seconds now = duration_cast<seconds>(system_clock::now().time_since_epoch());
 };
@@ -62,3 +67,36 @@ BOOST_FIXTURE_TEST_CASE(test_login_success_with_token, CacheInfoFixture)
 	BOOST_TEST(status == status::ok);
 	BOOST_TEST(body.at("playersonline").as_uint64() == 3);
 }
+
+BOOST_FIXTURE_TEST_CASE(test_cacheinfo_reuses_count_within_cache_time, CacheInfoFixture)
+{
+	setNumber(ConfigManager::STATUS_CACHE_TIME, 60000);
+
+	auto result = db.storeQuery(
+	    "INSERT INTO `accounts` (`name`, `email`, `password`, `secret`) VALUES ('foo', 'foo@example.com', SHA1('bar'), UNHEX('')) RETURNING `id`");
+	auto id = result->getNumber<uint64_t>("id");
+
+	DBInsert insertPlayers("INSERT INTO `players` (`account_id`, `name`) VALUES");
+	insertPlayers.addRow(fmt::format("{:d}, \"{:s}\"", id, "Dejairzin"));
+	insertPlayers.addRow(fmt::format("{:d}, \"{:s}\"", id, "Goraca"));
+	BOOST_TEST(insertPlayers.execute());
+
+	BOOST_TEST(db.executeQuery(fmt::format(
+	    "INSERT INTO `players_online` (`player_id`) SELECT `id` FROM `players` WHERE `account_id` = {:d} AND `name` = \"Dejairzin\"",
+	    id)));
+
+	{
+		auto&& [status, body] = tfs::http::handle_cacheinfo({{"type", "cacheinfo"}}, ip);
+		BOOST_TEST(status == status::ok);
+		BOOST_TEST(body.at("playersonline").as_uint64() == 1);
+	}
+
+	BOOST_TEST(db.executeQuery(fmt::format(
+	    "INSERT INTO `players_online` (`player_id`) SELECT `id` FROM `players` WHERE `account_id` = {:d} AND `name` = \"Goraca\"",
+	    id)));
+
+	// the second request is answered from the cache, without seeing the new online player
+	auto&& [status, body] = tfs::http::handle_cacheinfo({{"type", "cacheinfo"}}, ip);
+	BOOST_TEST(status == status::ok);
+	BOOST_TEST(body.at("playersonline").as_uint64() == 1);
+}
@@ -0,0 +1,35 @@
+#include "../otpch.h"
+
+#include "worker.h"
+
+#include "../database.h"
+
+#include <fmt/core.h>
+
+namespace {
+
+thread_local Database* workerDatabase = nullptr;
+
+} // namespace
+
+void tfs::http::run_worker(boost::asio::io_context& ioc)
+{
+	// requests would otherwise queue up behind each other and behind the game's own queries
+	Database database;
+	if (database.connect()) {
+		workerDatabase = &database;
+	} else {
+		fmt::print(stderr, "{}: could not connect to the database, using the shared connection.\n", __FUNCTION__);
+	}
+
+	ioc.run();
+	workerDatabase = nullptr;
+}
+
+Database& tfs::http::get_database()
+{
+	if (workerDatabase) {
+		return *workerDatabase;
+	}
+	return Database::getInstance();
+}
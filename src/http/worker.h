@@ -0,0 +1,15 @@
+#pragma once
+
+#include <boost/asio/io_context.hpp>
+
+class Database;
+
+namespace tfs::http {
+
+// Runs the io context on the calling thread, with a database connection of its own for the handlers
+void run_worker(boost::asio::io_context& ioc);
+
+// The connection of the calling HTTP worker, the server's shared connection on any other thread
+Database& get_database();
+
+} // namespace tfs::http
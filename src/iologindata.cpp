@@ -7,13 +7,63 @@
 
 #include "condition.h"
 #include "configmanager.h"
+#include "databasetasks.h"
 #include "depotchest.h"
 #include "game.h"
+#include "http/http.h"
 #include "inbox.h"
 #include "storeinbox.h"
 
 extern Game g_game;
 
+namespace {
+
+constexpr std::string_view playerColumns =
+    "`id`, `name`, `account_id`, `group_id`, `sex`, `vocation`, `experience`, `level`, `maglevel`, `health`, `healthmax`, `blessings`, `mana`, `manamax`, `manaspent`, `soul`, `lookbody`, `lookfeet`, `lookhead`, `looklegs`, `looktype`, `lookaddons`, `lookmount`, `lookmounthead`, `lookmountbody`, `lookmountlegs`, `lookmountfeet`, `currentmount`, `randomizemount`, `posx`, `posy`, `posz`, `cap`, `lastlogin`, `lastlogout`, `lastip`, `conditions`, `skulltime`, `skull`, `town_id`, `balance`, `offlinetraining_time`, `offlinetraining_skill`, `stamina`, `skill_fist`, `skill_fist_tries`, `skill_club`, `skill_club_tries`, `skill_sword`, `skill_sword_tries`, `skill_axe`, `skill_axe_tries`, `skill_dist`, `skill_dist_tries`, `skill_shielding`, `skill_shielding_tries`, `skill_fishing`, `skill_fishing_tries`, `direction`";
+
+std::string getPlayerQuery(IOLoginData::PlayerQuery query, uint32_t guid, uint32_t accountId)
+{
+	switch (query) {
+		case IOLoginData::PLAYERQUERY_PLAYER:
+			return fmt::format("SELECT {:s} FROM `players` WHERE `id` = {:d}", playerColumns, guid);
+		case IOLoginData::PLAYERQUERY_ACCOUNT:
+			return fmt::format("SELECT `type`, `premium_ends_at` FROM `accounts` WHERE `id` = {:d}", accountId);
+		case IOLoginData::PLAYERQUERY_GUILD:
+			return fmt::format(
+			    "SELECT `guild_id`, `rank_id`, `nick` FROM `guild_membership` WHERE `player_id` = {:d}", guid);
+		case IOLoginData::PLAYERQUERY_SPELLS:
+			return fmt::format("SELECT `player_id`, `name` FROM `player_spells` WHERE `player_id` = {:d}", guid);
+		case IOLoginData::PLAYERQUERY_ITEMS:
+			return fmt::format(
+			    "SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_items` WHERE `player_id` = {:d} ORDER BY `sid` DESC",
+			    guid);
+		case IOLoginData::PLAYERQUERY_DEPOTITEMS:
+			return fmt::format(
+			    "SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_depotitems` WHERE `player_id` = {:d} ORDER BY `sid` DESC",
+			    guid);
+		case IOLoginData::PLAYERQUERY_INBOXITEMS:
+			return fmt::format(
+			    "SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_inboxitems` WHERE `player_id` = {:d} ORDER BY `sid` DESC",
+			    guid);
+		case IOLoginData::PLAYERQUERY_STOREINBOXITEMS:
+			return fmt::format(
+			    "SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_storeinboxitems` WHERE `player_id` = {:d} ORDER BY `sid` DESC",
+			    guid);
+		case IOLoginData::PLAYERQUERY_STORAGE:
+			return fmt::format("SELECT `key`, `value` FROM `player_storage` WHERE `player_id` = {:d}", guid);
+		case IOLoginData::PLAYERQUERY_VIPLIST:
+			return fmt::format("SELECT `player_id` FROM `account_viplist` WHERE `account_id` = {:d}", accountId);
+		case IOLoginData::PLAYERQUERY_OUTFITS:
+			return fmt::format("SELECT `outfit_id`, `addons` FROM `player_outfits` WHERE `player_id` = {:d}", guid);
+		case IOLoginData::PLAYERQUERY_MOUNTS:
+			return fmt::format("SELECT `mount_id` FROM `player_mounts` WHERE `player_id` = {:d}", guid);
+		default:
+			return {};
+	}
+}
+
+} // namespace
+
 uint32_t IOLoginData::getAccountIdByPlayerName(const std::string& playerName)
 {
 	Database& db = Database::getInstance();
@@ -95,21 +145,14 @@ bool IOLoginData::preloadPlayer(Player* player)
 bool IOLoginData::loadPlayerById(Player* player, uint32_t id)
 {
 	Database& db = Database::getInstance();
-	return loadPlayer(
-	    player,
-	    db.storeQuery(fmt::format(
-	        "SELECT `id`, `name`, `account_id`, `group_id`, `sex`, `vocation`, `experience`, `level`, `maglevel`, `health`, `healthmax`, `blessings`, `mana`, `manamax`, `manaspent`, `soul`, `lookbody`, `lookfeet`, `lookhead`, `looklegs`, `looktype`, `lookaddons`, `lookmount`, `lookmounthead`, `lookmountbody`, `lookmountlegs`, `lookmountfeet`, `currentmount`, `randomizemount`, `posx`, `posy`, `posz`, `cap`, `lastlogin`, `lastlogout`, `lastip`, `conditions`, `skulltime`, `skull`, `town_id`, `balance`, `offlinetraining_time`, `offlinetraining_skill`, `stamina`, `skill_fist`, `skill_fist_tries`, `skill_club`, `skill_club_tries`, `skill_sword`, `skill_sword_tries`, `skill_axe`, `skill_axe_tries`, `skill_dist`, `skill_dist_tries`, `skill_shielding`, `skill_shielding_tries`, `skill_fishing`, `skill_fishing_tries`, `direction` FROM `players` WHERE `id` = {:d}",
-	        id)));
+	return loadPlayer(player, db.storeQuery(getPlayerQuery(PLAYERQUERY_PLAYER, id, 0)));
 }
 
 bool IOLoginData::loadPlayerByName(Player* player, const std::string& name)
 {
 	Database& db = Database::getInstance();
-	return loadPlayer(
-	    player,
-	    db.storeQuery(fmt::format(
-	        "SELECT `id`, `name`, `account_id`, `group_id`, `sex`, `vocation`, `experience`, `level`, `maglevel`, `health`, `healthmax`, `blessings`, `mana`, `manamax`, `manaspent`, `soul`, `lookbody`, `lookfeet`, `lookhead`, `looklegs`, `looktype`, `lookaddons`, `lookmount`, `lookmounthead`, `lookmountbody`, `lookmountlegs`, `lookmountfeet`, `currentmount`, `randomizemount`, `posx`, `posy`, `posz`, `cap`, `lastlogin`, `lastlogout`, `lastip`, `conditions`, `skulltime`, `skull`, `town_id`, `balance`, `offlinetraining_time`, `offlinetraining_skill`, `stamina`, `skill_fist`, `skill_fist_tries`, `skill_club`, `skill_club_tries`, `skill_sword`, `skill_sword_tries`, `skill_axe`, `skill_axe_tries`, `skill_dist`, `skill_dist_tries`, `skill_shielding`, `skill_shielding_tries`, `skill_fishing`, `skill_fishing_tries`, `direction` FROM `players` WHERE `name` = {:s}",
-	        db.escapeString(name))));
+	return loadPlayer(player, db.storeQuery(fmt::format("SELECT {:s} FROM `players` WHERE `name` = {:s}", playerColumns,
+	                                                    db.escapeString(name))));
 }
 
 static GuildWarVector getWarList(uint32_t guildId)
@@ -133,18 +176,60 @@ static GuildWarVector getWarList(uint32_t guildId)
 	return guildWarVector;
 }
 
+void IOLoginData::fetchPlayerById(uint32_t guid, uint32_t accountId, std::function<void(PlayerResults)> callback)
+{
+	// the tasks run in order on the database thread and their callbacks in order on the dispatcher, so the callback
+	// of the last query sees the results of all of them
+	auto results = std::make_shared<PlayerResults>();
+	for (size_t i = 0; i < PLAYERQUERY_LAST; ++i) {
+		const auto query = static_cast<PlayerQuery>(i);
+		if (query != PLAYERQUERY_LAST - 1) {
+			g_databaseTasks.addTask(
+			    getPlayerQuery(query, guid, accountId),
+			    [=](DBResult_ptr result, bool) { (*results)[query] = std::move(result); }, true);
+		} else {
+			g_databaseTasks.addTask(
+			    getPlayerQuery(query, guid, accountId),
+			    [=, callback = std::move(callback)](DBResult_ptr result, bool) {
+				    (*results)[query] = std::move(result);
+				    callback(std::move(*results));
+			    },
+			    true);
+		}
+	}
+}
+
 bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result)
 {
 	if (!result) {
 		return false;
 	}
 
+	uint32_t guid = result->getNumber<uint32_t>("id");
+	uint32_t accountId = result->getNumber<uint32_t>("account_id");
+
+	Database& db = Database::getInstance();
+
+	PlayerResults results;
+	results[PLAYERQUERY_PLAYER] = std::move(result);
+	for (size_t i = PLAYERQUERY_PLAYER + 1; i < PLAYERQUERY_LAST; ++i) {
+		results[i] = db.storeQuery(getPlayerQuery(static_cast<PlayerQuery>(i), guid, accountId));
+	}
+	return loadPlayer(player, results);
+}
+
+bool IOLoginData::loadPlayer(Player* player, const PlayerResults& results)
+{
+	DBResult_ptr result = results[PLAYERQUERY_PLAYER];
+	if (!result) {
+		return false;
+	}
+
 	Database& db = Database::getInstance();
 
 	uint32_t accountId = result->getNumber<uint32_t>("account_id");
 
-	auto account =
-	    db.storeQuery(fmt::format("SELECT `type`, `premium_ends_at` FROM `accounts` WHERE `id` = {:d}", accountId));
+	const auto& account = results[PLAYERQUERY_ACCOUNT];
 	if (!account) {
 		return false;
 	}
@@ -302,9 +387,7 @@ bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result)
 		player->skills[i].percent = Player::getBasisPointLevel(skillTries, nextSkillTries);
 	}
 
-	if ((result = db.storeQuery(
-	         fmt::format("SELECT `guild_id`, `rank_id`, `nick` FROM `guild_membership` WHERE `player_id` = {:d}",
-	                     player->getGUID())))) {
+	if ((result = results[PLAYERQUERY_GUILD])) {
 		uint32_t guildId = result->getNumber<uint32_t>("guild_id");
 		uint32_t playerRankId = result->getNumber<uint32_t>("rank_id");
 		player->guildNick = result->getString("nick");
@@ -346,8 +429,7 @@ bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result)
 		}
 	}
 
-	if ((result = db.storeQuery(fmt::format("SELECT `player_id`, `name` FROM `player_spells` WHERE `player_id` = {:d}",
-	                                        player->getGUID())))) {
+	if ((result = results[PLAYERQUERY_SPELLS])) {
 		do {
 			player->learnedInstantSpellList.emplace_front(result->getString("name"));
 		} while (result->next());
@@ -356,9 +438,7 @@ bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result)
 	// load inventory items
 	ItemMap itemMap;
 
-	if ((result = db.storeQuery(fmt::format(
-	         "SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_items` WHERE `player_id` = {:d} ORDER BY `sid` DESC",
-	         player->getGUID())))) {
+	if ((result = results[PLAYERQUERY_ITEMS])) {
 		loadItems(itemMap, result);
 
 		for (ItemMap::const_reverse_iterator it = itemMap.rbegin(), end = itemMap.rend(); it != end; ++it) {
@@ -385,9 +465,7 @@ bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result)
 	// load depot items
 	itemMap.clear();
 
-	if ((result = db.storeQuery(fmt::format(
-	         "SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_depotitems` WHERE `player_id` = {:d} ORDER BY `sid` DESC",
-	         player->getGUID())))) {
+	if ((result = results[PLAYERQUERY_DEPOTITEMS])) {
 		loadItems(itemMap, result);
 
 		for (ItemMap::const_reverse_iterator it = itemMap.rbegin(), end = itemMap.rend(); it != end; ++it) {
@@ -416,9 +494,7 @@ bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result)
 	// load inbox items
 	itemMap.clear();
 
-	if ((result = db.storeQuery(fmt::format(
-	         "SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_inboxitems` WHERE `player_id` = {:d} ORDER BY `sid` DESC",
-	         player->getGUID())))) {
+	if ((result = results[PLAYERQUERY_INBOXITEMS])) {
 		loadItems(itemMap, result);
 
 		for (ItemMap::const_reverse_iterator it = itemMap.rbegin(), end = itemMap.rend(); it != end; ++it) {
@@ -446,9 +522,7 @@ bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result)
 	// load store inbox items
 	itemMap.clear();
 
-	if ((result = db.storeQuery(fmt::format(
-	         "SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_storeinboxitems` WHERE `player_id` = {:d} ORDER BY `sid` DESC",
-	         player->getGUID())))) {
+	if ((result = results[PLAYERQUERY_STOREINBOXITEMS])) {
 		loadItems(itemMap, result);
 
 		for (ItemMap::const_reverse_iterator it = itemMap.rbegin(), end = itemMap.rend(); it != end; ++it) {
@@ -474,32 +548,28 @@ bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result)
 	}
 
 	// load storage map
-	if ((result = db.storeQuery(
-	         fmt::format("SELECT `key`, `value` FROM `player_storage` WHERE `player_id` = {:d}", player->getGUID())))) {
+	if ((result = results[PLAYERQUERY_STORAGE])) {
 		do {
 			player->setStorageValue(result->getNumber<uint32_t>("key"), result->getNumber<int32_t>("value"), true);
 		} while (result->next());
 	}
 
 	// load vip list
-	if ((result = db.storeQuery(fmt::format("SELECT `player_id` FROM `account_viplist` WHERE `account_id` = {:d}",
-	                                        player->getAccount())))) {
+	if ((result = results[PLAYERQUERY_VIPLIST])) {
 		do {
 			player->addVIPInternal(result->getNumber<uint32_t>("player_id"));
 		} while (result->next());
 	}
 
 	// load outfits & addons
-	if ((result = db.storeQuery(fmt::format(
-	         "SELECT `outfit_id`, `addons` FROM `player_outfits` WHERE `player_id` = {:d}", player->getGUID())))) {
+	if ((result = results[PLAYERQUERY_OUTFITS])) {
 		do {
 			player->addOutfit(result->getNumber<uint16_t>("outfit_id"), result->getNumber<uint8_t>("addons"));
 		} while (result->next());
 	}
 
 	// load mounts
-	if ((result = db.storeQuery(
-	         fmt::format("SELECT `mount_id` FROM `player_mounts` WHERE `player_id` = {:d}", player->getGUID())))) {
+	if ((result = results[PLAYERQUERY_MOUNTS])) {
 		do {
 			player->tameMount(result->getNumber<uint16_t>("mount_id"));
 		} while (result->next());
@@ -803,15 +873,20 @@ bool IOLoginData::savePlayer(Player* player)
 		return false;
 	}
 
-	if (!db.executeQuery(fmt::format("DELETE FROM `player_storage` WHERE `player_id` = {:d}", player->getGUID()))) {
-		return false;
-	}
-
-	DBInsert storageQuery("INSERT INTO `player_storage` (`player_id`, `key`, `value`) VALUES ");
+	// save storage, only the keys changed since the last save
+	std::string removedStorageKeys;
+	DBInsert storageQuery("INSERT INTO `player_storage` (`player_id`, `key`, `value`) VALUES ",
+	                      " ON DUPLICATE KEY UPDATE `value` = VALUES(`value`)");
 
-	for (const auto& [key, value] : player->getStorageMap()) {
-		if (!storageQuery.addRow(fmt::format("{:d}, {:d}, {:d}", player->getGUID(), key, value))) {
-			return false;
+	for (uint32_t key : player->modifiedStorageKeys) {
+		if (auto value = player->getStorageValue(key)) {
+			if (!storageQuery.addRow(fmt::format("{:d}, {:d}, {:d}", player->getGUID(), key, value.value()))) {
+				return false;
+			}
+		} else if (removedStorageKeys.empty()) {
+			removedStorageKeys = std::to_string(key);
+		} else {
+			removedStorageKeys += fmt::format(", {:d}", key);
 		}
 	}
 
@@ -819,6 +894,12 @@ bool IOLoginData::savePlayer(Player* player)
 		return false;
 	}
 
+	if (!removedStorageKeys.empty() &&
+	    !db.executeQuery(fmt::format("DELETE FROM `player_storage` WHERE `player_id` = {:d} AND `key` IN ({:s})",
+	                                 player->getGUID(), removedStorageKeys))) {
+		return false;
+	}
+
 	// save outfits & addons
 	if (!db.executeQuery(fmt::format("DELETE FROM `player_outfits` WHERE `player_id` = {:d}", player->getGUID()))) {
 		return false;
@@ -854,7 +935,16 @@ bool IOLoginData::savePlayer(Player* player)
 	}
 
 	// End the transaction
-	return transaction.commit();
+	if (!transaction.commit()) {
+		return false;
+	}
+
+#ifdef HTTP
+	tfs::http::invalidate_characters(player->getAccount());
+#endif
+
+	player->modifiedStorageKeys.clear();
+	return true;
 }
 
 std::string IOLoginData::getNameByGuid(uint32_t guid)
@@ -25,9 +25,33 @@ public:
 	static void updateOnlineStatus(uint32_t guid, bool login);
 	static bool preloadPlayer(Player* player);
 
+	// result sets a player is loaded from, all of them depend only on the player and account id
+	enum PlayerQuery : uint8_t
+	{
+		PLAYERQUERY_PLAYER,
+		PLAYERQUERY_ACCOUNT,
+		PLAYERQUERY_GUILD,
+		PLAYERQUERY_SPELLS,
+		PLAYERQUERY_ITEMS,
+		PLAYERQUERY_DEPOTITEMS,
+		PLAYERQUERY_INBOXITEMS,
+		PLAYERQUERY_STOREINBOXITEMS,
+		PLAYERQUERY_STORAGE,
+		PLAYERQUERY_VIPLIST,
+		PLAYERQUERY_OUTFITS,
+		PLAYERQUERY_MOUNTS,
+
+		PLAYERQUERY_LAST
+	};
+	using PlayerResults = std::array<DBResult_ptr, PLAYERQUERY_LAST>;
+
+	// runs the queries on the database thread and calls back on the dispatcher thread
+	static void fetchPlayerById(uint32_t guid, uint32_t accountId, std::function<void(PlayerResults)> callback);
+
 	static bool loadPlayerById(Player* player, uint32_t id);
 	static bool loadPlayerByName(Player* player, const std::string& name);
 	static bool loadPlayer(Player* player, DBResult_ptr result);
+	static bool loadPlayer(Player* player, const PlayerResults& results);
 	static bool savePlayer(Player* player);
 	static uint32_t getGuidByName(const std::string& name);
 	static bool getGuidByNameEx(uint32_t& guid, bool& specialVip, std::string& name);
@@ -143,6 +143,8 @@ bool IOMap::loadMap(Map* map, const std::filesystem::path& fileName)
 	}
 
 	std::cout << "> Map loading time: " << (OTSYS_TIME() - start) / (1000.) << " seconds." << std::endl;
+	std::cout << "> Map objects: " << StaticTile::getLiveObjects() + DynamicTile::getLiveObjects() << " tiles, "
+	          << Item::getLiveObjects() << " items." << std::endl;
 	return true;
 }
 
@@ -628,7 +628,7 @@ Attr_ReadValue Item::readAttr(AttrTypes_t attr, PropStream& propStream)
 					return ATTR_READ_ERROR;
 				}
 
-				getAttributes()->reflect[combatType] = reflect;
+				getAttributes()->getCombatModifiers().reflect[combatType] = reflect;
 			}
 			break;
 		}
@@ -647,7 +647,7 @@ Attr_ReadValue Item::readAttr(AttrTypes_t attr, PropStream& propStream)
 					return ATTR_READ_ERROR;
 				}
 
-				getAttributes()->boostPercent[combatType] = percent;
+				getAttributes()->getCombatModifiers().boostPercent[combatType] = percent;
 			}
 			break;
 		}
@@ -902,8 +902,8 @@ void Item::serializeAttr(PropWriteStream& propWriteStream) const
 		}
 	}
 
-	if (attributes) {
-		const auto& reflects = attributes->reflect;
+	if (attributes && attributes->combatModifiers) {
+		const auto& reflects = attributes->combatModifiers->reflect;
 		if (!reflects.empty()) {
 			propWriteStream.write<uint8_t>(ATTR_REFLECT);
 			propWriteStream.write<uint16_t>(reflects.size());
@@ -915,7 +915,7 @@ void Item::serializeAttr(PropWriteStream& propWriteStream) const
 			}
 		}
 
-		const auto& boosts = attributes->boostPercent;
+		const auto& boosts = attributes->combatModifiers->boostPercent;
 		if (!boosts.empty()) {
 			propWriteStream.write<uint8_t>(ATTR_BOOST);
 			propWriteStream.write<uint16_t>(boosts.size());
@@ -930,32 +930,37 @@ void Item::serializeAttr(PropWriteStream& propWriteStream) const
 
 bool Item::hasProperty(ITEMPROPERTY prop) const
 {
-	const ItemType& it = items[id];
+	const uint8_t flags = items.getItemTypeFlags(id);
+	const auto isImmovable = [&]() {
+		return (flags & ITEMTYPE_FLAG_MOVEABLE) == 0 || hasAttribute(ITEM_ATTRIBUTE_UNIQUEID);
+	};
+
 	switch (prop) {
 		case CONST_PROP_BLOCKSOLID:
-			return it.blockSolid;
+			return flags & ITEMTYPE_FLAG_BLOCKSOLID;
 		case CONST_PROP_MOVEABLE:
-			return it.moveable && !hasAttribute(ITEM_ATTRIBUTE_UNIQUEID);
+			return (flags & ITEMTYPE_FLAG_MOVEABLE) && !hasAttribute(ITEM_ATTRIBUTE_UNIQUEID);
 		case CONST_PROP_HASHEIGHT:
-			return it.hasHeight;
+			return flags & ITEMTYPE_FLAG_HASHEIGHT;
 		case CONST_PROP_BLOCKPROJECTILE:
-			return it.blockProjectile;
+			return flags & ITEMTYPE_FLAG_BLOCKPROJECTILE;
 		case CONST_PROP_BLOCKPATH:
-			return it.blockPathFind;
+			return flags & ITEMTYPE_FLAG_BLOCKPATH;
 		case CONST_PROP_ISVERTICAL:
-			return it.isVertical;
+			return flags & ITEMTYPE_FLAG_VERTICAL;
 		case CONST_PROP_ISHORIZONTAL:
-			return it.isHorizontal;
+			return flags & ITEMTYPE_FLAG_HORIZONTAL;
 		case CONST_PROP_IMMOVABLEBLOCKSOLID:
-			return it.blockSolid && (!it.moveable || hasAttribute(ITEM_ATTRIBUTE_UNIQUEID));
+			return (flags & ITEMTYPE_FLAG_BLOCKSOLID) && isImmovable();
 		case CONST_PROP_IMMOVABLEBLOCKPATH:
-			return it.blockPathFind && (!it.moveable || hasAttribute(ITEM_ATTRIBUTE_UNIQUEID));
+			return (flags & ITEMTYPE_FLAG_BLOCKPATH) && isImmovable();
 		case CONST_PROP_IMMOVABLENOFIELDBLOCKPATH:
-			return !it.isMagicField() && it.blockPathFind && (!it.moveable || hasAttribute(ITEM_ATTRIBUTE_UNIQUEID));
+			return (flags & (ITEMTYPE_FLAG_MAGICFIELD | ITEMTYPE_FLAG_BLOCKPATH)) == ITEMTYPE_FLAG_BLOCKPATH &&
+			       isImmovable();
 		case CONST_PROP_NOFIELDBLOCKPATH:
-			return !it.isMagicField() && it.blockPathFind;
+			return (flags & (ITEMTYPE_FLAG_MAGICFIELD | ITEMTYPE_FLAG_BLOCKPATH)) == ITEMTYPE_FLAG_BLOCKPATH;
 		case CONST_PROP_SUPPORTHANGABLE:
-			return it.isHorizontal || it.isVertical;
+			return flags & (ITEMTYPE_FLAG_HORIZONTAL | ITEMTYPE_FLAG_VERTICAL);
 		default:
 			return false;
 	}
@@ -1170,19 +1175,7 @@ void ItemAttributes::removeAttribute(itemAttrTypes type)
 		return;
 	}
 
-	auto prev_it = attributes.rbegin();
-	if ((*prev_it).type == type) {
-		attributes.pop_back();
-	} else {
-		auto it = prev_it, end = attributes.rend();
-		while (++it != end) {
-			if ((*it).type == type) {
-				(*it) = attributes.back();
-				attributes.pop_back();
-				break;
-			}
-		}
-	}
+	attributes.erase(attributes.begin() + getAttrIndex(type));
 	attributeBits &= ~type;
 }
 
@@ -1216,29 +1209,21 @@ void ItemAttributes::increaseIntAttr(itemAttrTypes type, int64_t value) { setInt
 
 const ItemAttributes::Attribute* ItemAttributes::getExistingAttr(itemAttrTypes type) const
 {
-	if (hasAttribute(type)) {
-		for (const Attribute& attribute : attributes) {
-			if (attribute.type == type) {
-				return &attribute;
-			}
-		}
+	if (!hasAttribute(type)) {
+		return nullptr;
 	}
-	return nullptr;
+	return &attributes[getAttrIndex(type)];
 }
 
 ItemAttributes::Attribute& ItemAttributes::getAttr(itemAttrTypes type)
 {
+	auto it = attributes.begin() + getAttrIndex(type);
 	if (hasAttribute(type)) {
-		for (Attribute& attribute : attributes) {
-			if (attribute.type == type) {
-				return attribute;
-			}
-		}
+		return *it;
 	}
 
 	attributeBits |= type;
-	attributes.emplace_back(type);
-	return attributes.back();
+	return *attributes.emplace(it, type);
 }
 
 void Item::startDecaying() { g_game.startDecay(this); }
@@ -6,6 +6,7 @@
 
 #include "items.h"
 #include "luascript.h"
+#include "slab.h"
 #include "thing.h"
 
 class BedItem;
@@ -101,10 +102,15 @@ enum Attr_ReadValue
 	ATTR_READ_END,
 };
 
-class ItemAttributes
+class ItemAttributes : public SlabAllocated<ItemAttributes>
 {
 public:
 	ItemAttributes() = default;
+	ItemAttributes(const ItemAttributes& other) :
+	    attributes(other.attributes),
+	    attributeBits(other.attributeBits),
+	    combatModifiers(other.combatModifiers ? std::make_unique<CombatModifiers>(*other.combatModifiers) : nullptr)
+	{}
 
 	void setSpecialDescription(const std::string& desc) { setStrAttr(ITEM_ATTRIBUTE_DESCRIPTION, desc); }
 	const std::string& getSpecialDescription() const { return getStrAttr(ITEM_ATTRIBUTE_DESCRIPTION); }
@@ -307,7 +313,7 @@ private:
 				memset(&value, 0, sizeof(value));
 			}
 		}
-		Attribute(Attribute&& attribute) : value(attribute.value), type(attribute.type)
+		Attribute(Attribute&& attribute) noexcept : value(attribute.value), type(attribute.type)
 		{
 			memset(&attribute.value, 0, sizeof(value));
 			attribute.type = ITEM_ATTRIBUTE_NONE;
@@ -320,12 +326,13 @@ private:
 				delete value.custom;
 			}
 		}
-		Attribute& operator=(Attribute other)
+		Attribute& operator=(const Attribute& other)
 		{
-			Attribute::swap(*this, other);
+			Attribute tmp(other);
+			Attribute::swap(*this, tmp);
 			return *this;
 		}
-		Attribute& operator=(Attribute&& other)
+		Attribute& operator=(Attribute&& other) noexcept
 		{
 			if (this != &other) {
 				if (ItemAttributes::isStrAttrType(type)) {
@@ -350,21 +357,46 @@ private:
 		}
 	};
 
+	// kept ordered by type, so the index of an attribute is the number of lower type bits set in attributeBits
 	std::vector<Attribute> attributes;
 	uint32_t attributeBits = 0;
 
-	std::map<CombatType_t, Reflect> reflect;
-	std::map<CombatType_t, uint16_t> boostPercent;
+	size_t getAttrIndex(itemAttrTypes type) const { return std::popcount(attributeBits & (type - 1)); }
+
+	// custom reflect and boost are rare, so they are only allocated for items that have them
+	struct CombatModifiers
+	{
+		std::map<CombatType_t, Reflect> reflect;
+		std::map<CombatType_t, uint16_t> boostPercent;
+	};
+
+	std::unique_ptr<CombatModifiers> combatModifiers;
+
+	CombatModifiers& getCombatModifiers()
+	{
+		if (!combatModifiers) {
+			combatModifiers = std::make_unique<CombatModifiers>();
+		}
+		return *combatModifiers;
+	}
 
 	const Reflect& getReflect(CombatType_t combatType)
 	{
-		auto it = reflect.find(combatType);
-		return it != reflect.end() ? it->second : emptyReflect;
+		if (!combatModifiers) {
+			return emptyReflect;
+		}
+
+		auto it = combatModifiers->reflect.find(combatType);
+		return it != combatModifiers->reflect.end() ? it->second : emptyReflect;
 	}
 	int16_t getBoostPercent(CombatType_t combatType)
 	{
-		auto it = boostPercent.find(combatType);
-		return it != boostPercent.end() ? it->second : 0;
+		if (!combatModifiers) {
+			return 0;
+		}
+
+		auto it = combatModifiers->boostPercent.find(combatType);
+		return it != combatModifiers->boostPercent.end() ? it->second : 0;
 	}
 
 	const std::string& getStrAttr(itemAttrTypes type) const;
@@ -488,7 +520,7 @@ public:
 	friend class Item;
 };
 
-class Item : virtual public Thing
+class Item : virtual public Thing, public SlabAllocated<Item>
 {
 public:
 	// Factory member to create item of right type based on type
@@ -811,10 +843,16 @@ public:
 	uint32_t getWorth() const;
 	LightInfo getLightInfo() const;
 
-	void setReflect(CombatType_t combatType, const Reflect& reflect) { getAttributes()->reflect[combatType] = reflect; }
+	void setReflect(CombatType_t combatType, const Reflect& reflect)
+	{
+		getAttributes()->getCombatModifiers().reflect[combatType] = reflect;
+	}
 	Reflect getReflect(CombatType_t combatType, bool total = true) const;
 
-	void setBoostPercent(CombatType_t combatType, uint16_t value) { getAttributes()->boostPercent[combatType] = value; }
+	void setBoostPercent(CombatType_t combatType, uint16_t value)
+	{
+		getAttributes()->getCombatModifiers().boostPercent[combatType] = value;
+	}
 	uint16_t getBoostPercent(CombatType_t combatType, bool total = true) const;
 
 	bool hasProperty(ITEMPROPERTY prop) const;
@@ -929,9 +967,6 @@ public:
 	const Tile* getTile() const override;
 	bool isRemoved() const override { return !getParent() || getParent()->isRemoved(); }
 
-protected:
-	uint16_t id; // the same id as in ItemType
-
 private:
 	std::string getWeightDescription(uint32_t weight) const;
 
@@ -939,6 +974,11 @@ private:
 
 	uint32_t referenceCounter = 0;
 
+protected:
+	// kept next to the reference counter and count so that together they fill a single word
+	uint16_t id; // the same id as in ItemType
+
+private:
 	uint8_t count = 1; // number of stacked items
 
 	bool loadedFromMap = false;
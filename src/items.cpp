@@ -5,10 +5,14 @@
 
 #include "items.h"
 
+#include "condition.h"
+#include "fileloader.h"
 #include "movement.h"
 #include "pugicast.h"
 #include "weapons.h"
 
+#include <fstream>
+
 extern MoveEvents* g_moveEvents;
 extern Weapons* g_weapons;
 
@@ -296,6 +300,214 @@ Direction getDirection(std::string_view string)
 	return DIRECTION_NORTH;
 }
 
+constexpr auto ITEMS_CACHE_FILE = "data/items/items.cache";
+
+// bump whenever the layout written by saveToCache changes
+constexpr uint32_t ITEMS_CACHE_VERSION = 1;
+
+static_assert(std::is_trivially_copyable_v<Abilities>);
+
+// The fields of an ItemType kept in the items cache, in the order they are stored. The abilities and the field
+// condition are owned through pointers and stored separately.
+template <typename ItemTypeT, typename Visitor>
+void forEachCachedField(ItemTypeT& it, Visitor&& visit)
+{
+	visit(it.group);
+	visit(it.type);
+	visit(it.id);
+	visit(it.clientId);
+	visit(it.stackable);
+	visit(it.isAnimation);
+
+	visit(it.name);
+	visit(it.article);
+	visit(it.pluralName);
+	visit(it.description);
+	visit(it.runeSpellName);
+	visit(it.vocationString);
+
+	visit(it.attackSpeed);
+	visit(it.weight);
+	visit(it.levelDoor);
+	visit(it.decayTimeMin);
+	visit(it.decayTimeMax);
+	visit(it.wieldInfo);
+	visit(it.minReqLevel);
+	visit(it.minReqMagicLevel);
+	visit(it.charges);
+	visit(it.maxHitChance);
+	visit(it.decayTo);
+	visit(it.attack);
+	visit(it.defense);
+	visit(it.extraDefense);
+	visit(it.armor);
+	visit(it.rotateTo);
+	visit(it.runeMagLevel);
+	visit(it.runeLevel);
+	visit(it.worth);
+
+	visit(it.combatType);
+
+	visit(it.transformToOnUse[0]);
+	visit(it.transformToOnUse[1]);
+	visit(it.transformToFree);
+	visit(it.destroyTo);
+	visit(it.maxTextLen);
+	visit(it.writeOnceItemId);
+	visit(it.transformEquipTo);
+	visit(it.transformDeEquipTo);
+	visit(it.maxItems);
+	visit(it.slotPosition);
+	visit(it.speed);
+	visit(it.wareId);
+
+	visit(it.magicEffect);
+	visit(it.bedPartnerDir);
+	visit(it.weaponType);
+	visit(it.ammoType);
+	visit(it.shootType);
+	visit(it.corpseType);
+	visit(it.fluidSource);
+
+	visit(it.floorChange);
+	visit(it.alwaysOnTopOrder);
+	visit(it.lightLevel);
+	visit(it.lightColor);
+	visit(it.shootRange);
+	visit(it.classification);
+	visit(it.hitChance);
+
+	visit(it.storeItem);
+	visit(it.forceUse);
+	visit(it.forceSerialize);
+	visit(it.hasHeight);
+	visit(it.walkStack);
+	visit(it.blockSolid);
+	visit(it.blockPickupable);
+	visit(it.blockProjectile);
+	visit(it.blockPathFind);
+	visit(it.allowPickupable);
+	visit(it.showDuration);
+	visit(it.showCharges);
+	visit(it.showAttributes);
+	visit(it.replaceable);
+	visit(it.pickupable);
+	visit(it.rotatable);
+	visit(it.useable);
+	visit(it.moveable);
+	visit(it.alwaysOnTop);
+	visit(it.canReadText);
+	visit(it.canWriteText);
+	visit(it.isVertical);
+	visit(it.isHorizontal);
+	visit(it.isHangable);
+	visit(it.allowDistRead);
+	visit(it.lookThrough);
+	visit(it.stopTime);
+	visit(it.showCount);
+	visit(it.supply);
+	visit(it.showClientCharges);
+	visit(it.showClientDuration);
+}
+
+void writeCacheField(PropWriteStream& stream, const std::string& value) { stream.writeString(value); }
+
+template <typename T>
+void writeCacheField(PropWriteStream& stream, const T& value)
+{
+	stream.write<T>(value);
+}
+
+bool readCacheField(PropStream& stream, std::string& value)
+{
+	auto [str, ok] = stream.readString();
+	value = str;
+	return ok;
+}
+
+template <typename T>
+bool readCacheField(PropStream& stream, T& value)
+{
+	return stream.read<T>(value);
+}
+
+void serializeItemType(PropWriteStream& stream, const ItemType& it)
+{
+	forEachCachedField(it, [&](const auto& field) { writeCacheField(stream, field); });
+
+	stream.write<uint8_t>(it.abilities ? 1 : 0);
+	if (it.abilities) {
+		stream.write<Abilities>(*it.abilities);
+	}
+
+	// the field condition is rebuilt from its damage rounds, as parseItemNode builds it
+	ConditionDamage* conditionDamage = it.conditionDamage.get();
+	stream.write<uint8_t>(conditionDamage ? 1 : 0);
+	if (conditionDamage) {
+		stream.write<ConditionId_t>(conditionDamage->getId());
+		stream.write<ConditionType_t>(conditionDamage->getType());
+		stream.write<int32_t>(conditionDamage->getInitDamage());
+		stream.write<int32_t>(conditionDamage->getParam(CONDITION_PARAM_FIELD));
+		stream.write<int32_t>(conditionDamage->getParam(CONDITION_PARAM_FORCEUPDATE));
+
+		const auto& damageList = conditionDamage->getDamageList();
+		stream.write<uint32_t>(damageList.size());
+		for (const IntervalInfo& intervalInfo : damageList) {
+			stream.write<IntervalInfo>(intervalInfo);
+		}
+	}
+}
+
+bool unserializeItemType(PropStream& stream, ItemType& it)
+{
+	bool ok = true;
+	forEachCachedField(it, [&](auto& field) { ok = ok && readCacheField(stream, field); });
+	if (!ok) {
+		return false;
+	}
+
+	uint8_t hasAbilities;
+	if (!stream.read<uint8_t>(hasAbilities)) {
+		return false;
+	}
+
+	if (hasAbilities != 0 && !stream.read<Abilities>(it.getAbilities())) {
+		return false;
+	}
+
+	uint8_t hasConditionDamage;
+	if (!stream.read<uint8_t>(hasConditionDamage)) {
+		return false;
+	}
+
+	if (hasConditionDamage != 0) {
+		ConditionId_t conditionId;
+		ConditionType_t conditionType;
+		int32_t initDamage, field, forceUpdate;
+		uint32_t rounds;
+		if (!stream.read<ConditionId_t>(conditionId) || !stream.read<ConditionType_t>(conditionType) ||
+		    !stream.read<int32_t>(initDamage) || !stream.read<int32_t>(field) ||
+		    !stream.read<int32_t>(forceUpdate) || !stream.read<uint32_t>(rounds)) {
+			return false;
+		}
+
+		auto conditionDamage = std::make_unique<ConditionDamage>(conditionId, conditionType);
+		for (uint32_t i = 0; i < rounds; ++i) {
+			IntervalInfo intervalInfo;
+			if (!stream.read<IntervalInfo>(intervalInfo)) {
+				return false;
+			}
+			conditionDamage->addDamage(1, intervalInfo.interval, intervalInfo.value);
+		}
+
+		conditionDamage->setInitDamage(initDamage);
+		conditionDamage->setParam(CONDITION_PARAM_FIELD, field);
+		conditionDamage->setParam(CONDITION_PARAM_FORCEUPDATE, forceUpdate);
+		it.conditionDamage = std::move(conditionDamage);
+	}
+	return true;
+}
+
 } // namespace
 
 Items::Items()
@@ -307,10 +519,12 @@ Items::Items()
 void Items::clear()
 {
 	items.clear();
+	itemTypeFlags.clear();
 	clientIdToServerIdMap.clear();
 	nameToItems.clear();
 	currencyItems.clear();
 	inventory.clear();
+	otbHash.clear();
 }
 
 bool Items::reload()
@@ -574,13 +788,34 @@ bool Items::loadFromOtb(const std::string& file)
 	}
 
 	items.shrink_to_fit();
+
+	OTB::MappedFile otbFile{file};
+	otbHash = transformToSHA1({otbFile.data(), otbFile.size()});
 	return true;
 }
 
 bool Items::loadFromXml()
 {
+	boost::iostreams::mapped_file_source xmlFile;
+	try {
+		xmlFile.open("data/items/items.xml");
+	} catch (const std::exception& e) {
+		std::cout << "[Error - Items::loadFromXml] Cannot open data/items/items.xml: " << e.what() << std::endl;
+		return false;
+	}
+
+	// the cached table is built from both files, so it is only valid for the exact pair it was written from
+	std::string cacheKey;
+	if (!otbHash.empty()) {
+		cacheKey = otbHash + transformToSHA1({xmlFile.data(), xmlFile.size()});
+		if (loadFromCache(cacheKey)) {
+			buildItemTypeFlags();
+			return true;
+		}
+	}
+
 	pugi::xml_document doc;
-	pugi::xml_parse_result result = doc.load_file("data/items/items.xml");
+	pugi::xml_parse_result result = doc.load_buffer(xmlFile.data(), xmlFile.size());
 	if (!result) {
 		printXMLError("Error - Items::loadFromXml", "data/items/items.xml", result);
 		return false;
@@ -613,9 +848,171 @@ bool Items::loadFromXml()
 		}
 	}
 
+	buildItemTypeFlags();
+
+	if (!cacheKey.empty()) {
+		saveToCache(cacheKey);
+	}
 	return true;
 }
 
+void Items::buildItemTypeFlags()
+{
+	itemTypeFlags.assign(items.size(), 0);
+	for (size_t id = 0; id < items.size(); ++id) {
+		const ItemType& it = items[id];
+
+		uint8_t& flags = itemTypeFlags[id];
+		if (it.blockSolid) {
+			flags |= ITEMTYPE_FLAG_BLOCKSOLID;
+		}
+		if (it.moveable) {
+			flags |= ITEMTYPE_FLAG_MOVEABLE;
+		}
+		if (it.hasHeight) {
+			flags |= ITEMTYPE_FLAG_HASHEIGHT;
+		}
+		if (it.blockProjectile) {
+			flags |= ITEMTYPE_FLAG_BLOCKPROJECTILE;
+		}
+		if (it.blockPathFind) {
+			flags |= ITEMTYPE_FLAG_BLOCKPATH;
+		}
+		if (it.isVertical) {
+			flags |= ITEMTYPE_FLAG_VERTICAL;
+		}
+		if (it.isHorizontal) {
+			flags |= ITEMTYPE_FLAG_HORIZONTAL;
+		}
+		if (it.isMagicField()) {
+			flags |= ITEMTYPE_FLAG_MAGICFIELD;
+		}
+	}
+}
+
+bool Items::loadFromCache(std::string_view key)
+{
+	if (!std::filesystem::exists(ITEMS_CACHE_FILE)) {
+		return false;
+	}
+
+	boost::iostreams::mapped_file_source file;
+	try {
+		file.open(ITEMS_CACHE_FILE);
+	} catch (const std::exception&) {
+		return false;
+	}
+
+	PropStream stream;
+	stream.init(file.data(), file.size());
+
+	uint32_t version, abilitiesSize, itemCount;
+	if (!stream.read<uint32_t>(version) || version != ITEMS_CACHE_VERSION ||
+	    !stream.read<uint32_t>(abilitiesSize) || abilitiesSize != sizeof(Abilities)) {
+		return false;
+	}
+
+	auto [cachedKey, ok] = stream.readString();
+	if (!ok || cachedKey != key) {
+		return false;
+	}
+
+	if (!stream.read<uint32_t>(itemCount) || itemCount != items.size()) {
+		return false;
+	}
+
+	// nothing is replaced until the whole file has been read, a damaged cache falls back to parsing items.xml
+	std::vector<ItemType> cachedItems(itemCount);
+	for (ItemType& it : cachedItems) {
+		if (!unserializeItemType(stream, it)) {
+			return false;
+		}
+	}
+
+	uint32_t nameCount;
+	if (!stream.read<uint32_t>(nameCount)) {
+		return false;
+	}
+
+	NameMap cachedNames;
+	cachedNames.reserve(nameCount);
+	for (uint32_t i = 0; i < nameCount; ++i) {
+		auto [name, nameOk] = stream.readString();
+		uint16_t id;
+		if (!nameOk || !stream.read<uint16_t>(id)) {
+			return false;
+		}
+		cachedNames.emplace(name, id);
+	}
+
+	uint32_t currencyCount;
+	if (!stream.read<uint32_t>(currencyCount)) {
+		return false;
+	}
+
+	CurrencyMap cachedCurrencies;
+	for (uint32_t i = 0; i < currencyCount; ++i) {
+		uint64_t worth;
+		uint16_t id;
+		if (!stream.read<uint64_t>(worth) || !stream.read<uint16_t>(id)) {
+			return false;
+		}
+		cachedCurrencies.emplace(worth, id);
+	}
+
+	if (stream.size() != 0) {
+		return false;
+	}
+
+	items = std::move(cachedItems);
+	nameToItems = std::move(cachedNames);
+	currencyItems = std::move(cachedCurrencies);
+	return true;
+}
+
+void Items::saveToCache(std::string_view key) const
+{
+	PropWriteStream stream;
+	stream.write<uint32_t>(ITEMS_CACHE_VERSION);
+	stream.write<uint32_t>(sizeof(Abilities));
+	stream.writeString(std::string{key});
+
+	stream.write<uint32_t>(items.size());
+	for (const ItemType& it : items) {
+		serializeItemType(stream, it);
+	}
+
+	stream.write<uint32_t>(nameToItems.size());
+	for (const auto& [name, id] : nameToItems) {
+		stream.writeString(name);
+		stream.write<uint16_t>(id);
+	}
+
+	stream.write<uint32_t>(currencyItems.size());
+	for (const auto& [worth, id] : currencyItems) {
+		stream.write<uint64_t>(worth);
+		stream.write<uint16_t>(id);
+	}
+
+	// written next to the cache and renamed over it, so a server stopped halfway never leaves a torn file behind
+	const std::string tmpFile = std::string{ITEMS_CACHE_FILE} + ".tmp";
+	{
+		std::ofstream os{tmpFile, std::ios::binary | std::ios::trunc};
+		auto data = stream.getStream();
+		if (!os.write(data.data(), data.size())) {
+			std::cout << "[Warning - Items::saveToCache] Cannot write " << tmpFile << std::endl;
+			return;
+		}
+	}
+
+	std::error_code ec;
+	std::filesystem::rename(tmpFile, ITEMS_CACHE_FILE, ec);
+	if (ec) {
+		std::cout << "[Warning - Items::saveToCache] Cannot replace " << ITEMS_CACHE_FILE << ": " << ec.message()
+		          << std::endl;
+	}
+}
+
 void Items::parseItemNode(const pugi::xml_node& itemNode, uint16_t id)
 {
 	if (id > 0 && id < 100) {
@@ -654,6 +1051,8 @@ void Items::parseItemNode(const pugi::xml_node& itemNode, uint16_t id)
 
 	Abilities& abilities = it.getAbilities();
 
+	// lowercased keys and values are written into one buffer to avoid an allocation per attribute
+	std::string tmpStrValue;
 	for (auto attributeNode : itemNode.children()) {
 		pugi::xml_attribute keyAttribute = attributeNode.attribute("key");
 		if (!keyAttribute) {
@@ -674,13 +1073,15 @@ void Items::parseItemNode(const pugi::xml_node& itemNode, uint16_t id)
 			}
 		}
 
-		std::string tmpStrValue = boost::algorithm::to_lower_copy<std::string>(keyAttribute.as_string());
+		tmpStrValue = keyAttribute.as_string();
+		boost::algorithm::to_lower(tmpStrValue);
 		auto parseAttribute = ItemParseAttributesMap.find(tmpStrValue);
 		if (parseAttribute != ItemParseAttributesMap.end()) {
 			ItemParseAttributes_t parseType = parseAttribute->second;
 			switch (parseType) {
 				case ITEM_PARSE_TYPE: {
-					tmpStrValue = boost::algorithm::to_lower_copy<std::string>(valueAttribute.as_string());
+					tmpStrValue = valueAttribute.as_string();
+					boost::algorithm::to_lower(tmpStrValue);
 					auto it2 = ItemTypesMap.find(tmpStrValue);
 					if (it2 != ItemTypesMap.end()) {
 						it.type = it2->second;
@@ -775,7 +1176,8 @@ void Items::parseItemNode(const pugi::xml_node& itemNode, uint16_t id)
 				}
 
 				case ITEM_PARSE_FLOORCHANGE: {
-					tmpStrValue = boost::algorithm::to_lower_copy<std::string>(valueAttribute.as_string());
+					tmpStrValue = valueAttribute.as_string();
+					boost::algorithm::to_lower(tmpStrValue);
 					auto it2 = TileStatesMap.find(tmpStrValue);
 					if (it2 != TileStatesMap.end()) {
 						it.floorChange |= it2->second;
@@ -787,7 +1189,8 @@ void Items::parseItemNode(const pugi::xml_node& itemNode, uint16_t id)
 				}
 
 				case ITEM_PARSE_CORPSETYPE: {
-					tmpStrValue = boost::algorithm::to_lower_copy<std::string>(valueAttribute.as_string());
+					tmpStrValue = valueAttribute.as_string();
+					boost::algorithm::to_lower(tmpStrValue);
 					auto it2 = RaceTypesMap.find(tmpStrValue);
 					if (it2 != RaceTypesMap.end()) {
 						it.corpseType = it2->second;
@@ -804,7 +1207,8 @@ void Items::parseItemNode(const pugi::xml_node& itemNode, uint16_t id)
 				}
 
 				case ITEM_PARSE_FLUIDSOURCE: {
-					tmpStrValue = boost::algorithm::to_lower_copy<std::string>(valueAttribute.as_string());
+					tmpStrValue = valueAttribute.as_string();
+					boost::algorithm::to_lower(tmpStrValue);
 					auto it2 = FluidTypesMap.find(tmpStrValue);
 					if (it2 != FluidTypesMap.end()) {
 						it.fluidSource = it2->second;
@@ -837,7 +1241,8 @@ void Items::parseItemNode(const pugi::xml_node& itemNode, uint16_t id)
 				}
 
 				case ITEM_PARSE_WEAPONTYPE: {
-					tmpStrValue = boost::algorithm::to_lower_copy<std::string>(valueAttribute.as_string());
+					tmpStrValue = valueAttribute.as_string();
+					boost::algorithm::to_lower(tmpStrValue);
 					auto it2 = WeaponTypesMap.find(tmpStrValue);
 					if (it2 != WeaponTypesMap.end()) {
 						it.weaponType = it2->second;
@@ -849,7 +1254,8 @@ void Items::parseItemNode(const pugi::xml_node& itemNode, uint16_t id)
 				}
 
 				case ITEM_PARSE_SLOTTYPE: {
-					tmpStrValue = boost::algorithm::to_lower_copy<std::string>(valueAttribute.as_string());
+					tmpStrValue = valueAttribute.as_string();
+					boost::algorithm::to_lower(tmpStrValue);
 					if (tmpStrValue == "head") {
 						it.slotPosition |= SLOTP_HEAD;
 					} else if (tmpStrValue == "body") {
@@ -1659,7 +2065,8 @@ void Items::parseItemNode(const pugi::xml_node& itemNode, uint16_t id)
 					CombatType_t combatType = COMBAT_NONE;
 					ConditionDamage* conditionDamage = nullptr;
 
-					tmpStrValue = boost::algorithm::to_lower_copy<std::string>(valueAttribute.as_string());
+					tmpStrValue = valueAttribute.as_string();
+					boost::algorithm::to_lower(tmpStrValue);
 					if (tmpStrValue == "fire") {
 						conditionDamage = new ConditionDamage(CONDITIONID_COMBAT, CONDITION_FIRE);
 						combatType = COMBAT_FIREDAMAGE;
@@ -1700,7 +2107,8 @@ void Items::parseItemNode(const pugi::xml_node& itemNode, uint16_t id)
 								continue;
 							}
 
-							tmpStrValue = boost::algorithm::to_lower_copy<std::string>(subKeyAttribute.as_string());
+							tmpStrValue = subKeyAttribute.as_string();
+							boost::algorithm::to_lower(tmpStrValue);
 							if (tmpStrValue == "initdamage") {
 								initDamage = pugi::cast<int32_t>(subValueAttribute.value());
 							} else if (tmpStrValue == "ticks") {
@@ -1919,7 +2327,7 @@ uint16_t Items::getItemIdByName(const std::string& name)
 		return 0;
 	}
 
-	auto result = nameToItems.find(boost::algorithm::to_lower_copy(name));
+	auto result = nameToItems.find(name);
 	if (result == nameToItems.end()) return 0;
 
 	return result->second;
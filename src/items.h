@@ -8,6 +8,7 @@
 #include "enums.h"
 #include "itemloader.h"
 #include "position.h"
+#include "tools.h"
 
 class ConditionDamage;
 
@@ -256,6 +257,20 @@ struct Abilities
 	bool regeneration = false;
 };
 
+// Copies of the ItemType flags that are checked for every item whenever a tile is queried by movement and path
+// finding, packed per item id so those checks do not have to load the (much larger) ItemType.
+enum ItemTypeFlags : uint8_t
+{
+	ITEMTYPE_FLAG_BLOCKSOLID = 1 << 0,
+	ITEMTYPE_FLAG_MOVEABLE = 1 << 1,
+	ITEMTYPE_FLAG_HASHEIGHT = 1 << 2,
+	ITEMTYPE_FLAG_BLOCKPROJECTILE = 1 << 3,
+	ITEMTYPE_FLAG_BLOCKPATH = 1 << 4,
+	ITEMTYPE_FLAG_VERTICAL = 1 << 5,
+	ITEMTYPE_FLAG_HORIZONTAL = 1 << 6,
+	ITEMTYPE_FLAG_MAGICFIELD = 1 << 7,
+};
+
 class ItemType
 {
 public:
@@ -420,7 +435,7 @@ public:
 class Items
 {
 public:
-	using NameMap = std::unordered_map<std::string, uint16_t>;
+	using NameMap = std::unordered_map<std::string, uint16_t, CaseInsensitiveHash, CaseInsensitiveEqual>;
 	using InventoryVector = std::vector<uint16_t>;
 
 	using CurrencyMap = std::map<uint64_t, uint16_t, std::greater<uint64_t>>;
@@ -443,6 +458,8 @@ public:
 
 	uint16_t getItemIdByName(const std::string& name);
 
+	uint8_t getItemTypeFlags(size_t id) const { return id < itemTypeFlags.size() ? itemTypeFlags[id] : 0; }
+
 	uint32_t majorVersion = 0;
 	uint32_t minorVersion = 0;
 	uint32_t buildNumber = 0;
@@ -456,8 +473,15 @@ public:
 	CurrencyMap currencyItems;
 
 private:
+	void buildItemTypeFlags();
+
+	bool loadFromCache(std::string_view key);
+	void saveToCache(std::string_view key) const;
+
 	std::vector<ItemType> items;
+	std::vector<uint8_t> itemTypeFlags;
 	InventoryVector inventory;
+	std::string otbHash;
 	class ClientIdToServerIdMap
 	{
 	public:
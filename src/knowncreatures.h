@@ -0,0 +1,121 @@
+// Copyright 2023 The Forgotten Server Authors. All rights reserved.
+// Use of this source code is governed by the GPL-2.0 License that can be found in the LICENSE file.
+
+#ifndef FS_KNOWNCREATURES_H
+#define FS_KNOWNCREATURES_H
+
+/*
+ * The creatures a game client has been sent a full description of, at most LIMIT of them. Ids live in a flat open
+ * addressing table with linear probing and backward shift deletion, so the table never allocates and never needs
+ * tombstones. Once full, a creature is evicted with the clock algorithm: a lookup or insertion marks a creature as
+ * referenced, the clock hand sweeps the table clearing those marks and asks the caller whether the first unmarked
+ * creature may be forgotten. Creatures described to the client since the last sweep are thus passed over without
+ * asking, and the creature evicted only depends on the order of the calls.
+ */
+class KnownCreatures
+{
+public:
+	static constexpr size_t LIMIT = 1300;
+
+	// returns whether the creature is known and marks it as referenced
+	bool contains(uint32_t id)
+	{
+		for (size_t i = getHomeSlot(id); ids[i] != 0; i = (i + 1) & SLOT_MASK) {
+			if (ids[i] == id) {
+				referenced.set(i);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * Adds a creature that is not known yet.
+	 *
+	 * @param canEvict called with the ids of eviction candidates when the table is full
+	 * @return the id of the evicted creature, 0 if there was room left
+	 */
+	template <typename Predicate>
+	uint32_t insert(uint32_t id, Predicate&& canEvict)
+	{
+		uint32_t evicted = 0;
+		if (count >= LIMIT) {
+			evicted = evict(canEvict);
+		}
+
+		size_t i = getHomeSlot(id);
+		while (ids[i] != 0) {
+			i = (i + 1) & SLOT_MASK;
+		}
+
+		ids[i] = id;
+		referenced.set(i);
+		++count;
+		return evicted;
+	}
+
+	size_t size() const { return count; }
+
+private:
+	// a power of two keeping the load factor below 2/3
+	static constexpr size_t SLOT_COUNT = 2048;
+	static constexpr size_t SLOT_MASK = SLOT_COUNT - 1;
+
+	static size_t getHomeSlot(uint32_t id)
+	{
+		// fibonacci hashing, creature ids are handed out sequentially
+		return (id * 2654435769u) >> (32 - std::countr_zero(SLOT_COUNT));
+	}
+
+	template <typename Predicate>
+	uint32_t evict(Predicate& canEvict)
+	{
+		// the first sweep may only clear marks, the second one offers every creature
+		for (size_t step = 0; step < 2 * SLOT_COUNT; ++step) {
+			size_t i = hand;
+			hand = (hand + 1) & SLOT_MASK;
+
+			if (ids[i] == 0) {
+				continue;
+			}
+
+			if (referenced.test(i)) {
+				referenced.reset(i);
+			} else if (canEvict(ids[i])) {
+				return erase(i);
+			}
+		}
+
+		// nothing may be forgotten, replace the creature under the hand anyway
+		while (ids[hand] == 0) {
+			hand = (hand + 1) & SLOT_MASK;
+		}
+		return erase(hand);
+	}
+
+	uint32_t erase(size_t i)
+	{
+		uint32_t id = ids[i];
+
+		// pull back every following entry of the cluster that would no longer be reachable from its home slot
+		for (size_t j = (i + 1) & SLOT_MASK; ids[j] != 0; j = (j + 1) & SLOT_MASK) {
+			if (((j - getHomeSlot(ids[j])) & SLOT_MASK) >= ((j - i) & SLOT_MASK)) {
+				ids[i] = ids[j];
+				referenced[i] = referenced[j];
+				i = j;
+			}
+		}
+
+		ids[i] = 0;
+		referenced.reset(i);
+		--count;
+		return id;
+	}
+
+	std::array<uint32_t, SLOT_COUNT> ids = {};
+	std::bitset<SLOT_COUNT> referenced;
+	size_t count = 0;
+	size_t hand = 0;
+};
+
+#endif // FS_KNOWNCREATURES_H
@@ -25,10 +25,12 @@
 #include "movement.h"
 #include "npc.h"
 #include "outfit.h"
+#include "outputmessage.h"
 #include "party.h"
 #include "player.h"
 #include "podium.h"
 #include "protocolstatus.h"
+#include "ratelimit.h"
 #include "scheduler.h"
 #include "script.h"
 #include "spectators.h"
@@ -2000,6 +2002,7 @@ void LuaScriptInterface::registerFunctions()
 	registerEnum(L, TILESTATE_FLOORCHANGE_SOUTH_ALT);
 	registerEnum(L, TILESTATE_FLOORCHANGE_EAST_ALT);
 	registerEnum(L, TILESTATE_SUPPORTS_HANGABLE);
+	registerEnum(L, TILESTATE_BLOCKPROJECTILE);
 
 	registerEnum(L, WEAPON_NONE);
 	registerEnum(L, WEAPON_SWORD);
@@ -2015,6 +2018,12 @@ void LuaScriptInterface::registerFunctions()
 	registerEnum(L, WORLD_TYPE_PVP);
 	registerEnum(L, WORLD_TYPE_PVP_ENFORCED);
 
+	registerEnum(L, CONNECTION_DROP_CONNECTION_RATE);
+	registerEnum(L, CONNECTION_DROP_STATUS_RATE);
+	registerEnum(L, CONNECTION_DROP_PACKET_RATE);
+	registerEnum(L, CONNECTION_DROP_LOGIN_RATE);
+	registerEnum(L, CONNECTION_DROP_LOGIN_BACKLOG);
+
 	// Use with container:addItem, container:addItemEx and possibly other functions.
 	registerEnum(L, FLAG_NOLIMIT);
 	registerEnum(L, FLAG_IGNOREBLOCKITEM);
@@ -2367,6 +2376,9 @@ void LuaScriptInterface::registerFunctions()
 	registerMethod(L, "Game", "getMonsterCount", LuaScriptInterface::luaGameGetMonsterCount);
 	registerMethod(L, "Game", "getPlayerCount", LuaScriptInterface::luaGameGetPlayerCount);
 	registerMethod(L, "Game", "getNpcCount", LuaScriptInterface::luaGameGetNpcCount);
+	registerMethod(L, "Game", "getConnectionDrops", LuaScriptInterface::luaGameGetConnectionDrops);
+	registerMethod(L, "Game", "getOutputMessagePoolStats", LuaScriptInterface::luaGameGetOutputMessagePoolStats);
+	registerMethod(L, "Game", "getAutosendLatencyStats", LuaScriptInterface::luaGameGetAutosendLatencyStats);
 	registerMethod(L, "Game", "getMonsterTypes", LuaScriptInterface::luaGameGetMonsterTypes);
 	registerMethod(L, "Game", "getBestiary", LuaScriptInterface::luaGameGetBestiary);
 	registerMethod(L, "Game", "getCurrencyItems", LuaScriptInterface::luaGameGetCurrencyItems);
@@ -2712,6 +2724,8 @@ void LuaScriptInterface::registerFunctions()
 
 	registerMethod(L, "Creature", "getStorageValue", LuaScriptInterface::luaCreatureGetStorageValue);
 	registerMethod(L, "Creature", "setStorageValue", LuaScriptInterface::luaCreatureSetStorageValue);
+	registerMethod(L, "Creature", "getStorageValues", LuaScriptInterface::luaCreatureGetStorageValues);
+	registerMethod(L, "Creature", "setStorageValues", LuaScriptInterface::luaCreatureSetStorageValues);
 
 	// Player
 	registerClass(L, "Player", "Creature", LuaScriptInterface::luaPlayerCreate);
@@ -4649,6 +4663,42 @@ int LuaScriptInterface::luaGameGetNpcCount(lua_State* L)
 	return 1;
 }
 
+int LuaScriptInterface::luaGameGetConnectionDrops(lua_State* L)
+{
+	// Game.getConnectionDrops(reason)
+	auto reason = tfs::lua::getNumber<ConnectionDropReason>(L, 1);
+	if (reason >= CONNECTION_DROP_LAST) {
+		lua_pushnil(L);
+		return 1;
+	}
+
+	lua_pushnumber(L, getConnectionDrops(reason));
+	return 1;
+}
+
+int LuaScriptInterface::luaGameGetOutputMessagePoolStats(lua_State* L)
+{
+	// Game.getOutputMessagePoolStats()
+	auto stats = tfs::net::get_output_message_pool_stats();
+	lua_createtable(L, 0, 4);
+	setField(L, "hits", stats.hits);
+	setField(L, "misses", stats.misses);
+	setField(L, "live", stats.live);
+	setField(L, "peak", stats.peak);
+	return 1;
+}
+
+int LuaScriptInterface::luaGameGetAutosendLatencyStats(lua_State* L)
+{
+	// Game.getAutosendLatencyStats()
+	auto stats = tfs::net::get_autosend_latency_stats();
+	lua_createtable(L, 0, 3);
+	setField(L, "samples", stats.samples);
+	setField(L, "total", stats.totalMicroseconds);
+	setField(L, "max", stats.maxMicroseconds);
+	return 1;
+}
+
 int LuaScriptInterface::luaGameGetMonsterTypes(lua_State* L)
 {
 	// Game.getMonsterTypes()
@@ -8968,6 +9018,60 @@ int LuaScriptInterface::luaCreatureSetStorageValue(lua_State* L)
 	return 1;
 }
 
+int LuaScriptInterface::luaCreatureGetStorageValues(lua_State* L)
+{
+	// creature:getStorageValues(keys)
+	Creature* creature = tfs::lua::getUserdata<Creature>(L, 1);
+	if (!creature || !lua_istable(L, 2)) {
+		lua_pushnil(L);
+		return 1;
+	}
+
+	lua_createtable(L, 0, lua_rawlen(L, 2));
+
+	lua_pushnil(L);
+	while (lua_next(L, 2) != 0) {
+		uint32_t key = tfs::lua::getNumber<uint32_t>(L, -1);
+		lua_pop(L, 1);
+
+		if (auto storage = creature->getStorageValue(key)) {
+			lua_pushnumber(L, key);
+			lua_pushnumber(L, storage.value());
+			lua_rawset(L, -4);
+		}
+	}
+	return 1;
+}
+
+int LuaScriptInterface::luaCreatureSetStorageValues(lua_State* L)
+{
+	// creature:setStorageValues(values)
+	Creature* creature = tfs::lua::getUserdata<Creature>(L, 1);
+	if (!creature || !lua_istable(L, 2)) {
+		lua_pushnil(L);
+		return 1;
+	}
+
+	// a table cannot hold nil, so false removes a key
+	bool success = true;
+	lua_pushnil(L);
+	while (lua_next(L, 2) != 0) {
+		uint32_t key = tfs::lua::getNumber<uint32_t>(L, -2);
+		if (IS_IN_KEYRANGE(key, RESERVED_RANGE)) {
+			reportErrorFunc(L, fmt::format("Accessing reserved range: {:d}", key));
+			success = false;
+		} else if (lua_isboolean(L, -1) && !tfs::lua::getBoolean(L, -1)) {
+			creature->setStorageValue(key, std::nullopt);
+		} else {
+			creature->setStorageValue(key, tfs::lua::getNumber<int32_t>(L, -1));
+		}
+		lua_pop(L, 1);
+	}
+
+	tfs::lua::pushBoolean(L, success);
+	return 1;
+}
+
 // Player
 int LuaScriptInterface::luaPlayerCreate(lua_State* L)
 {
@@ -15595,7 +15699,7 @@ int LuaScriptInterface::luaLootSetId(lua_State* L)
 			loot->lootBlock.id = tfs::lua::getNumber<uint16_t>(L, 2);
 		} else {
 			auto name = tfs::lua::getString(L, 2);
-			auto ids = Item::items.nameToItems.equal_range(boost::algorithm::to_lower_copy(name));
+			auto ids = Item::items.nameToItems.equal_range(name);
 
 			if (ids.first == Item::items.nameToItems.cend()) {
 				std::cout << "[Warning - Loot:setId] Unknown loot item \"" << name << "\".\n";
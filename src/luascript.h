@@ -274,6 +274,9 @@ private:
 	static int luaGameGetMonsterCount(lua_State* L);
 	static int luaGameGetPlayerCount(lua_State* L);
 	static int luaGameGetNpcCount(lua_State* L);
+	static int luaGameGetConnectionDrops(lua_State* L);
+	static int luaGameGetOutputMessagePoolStats(lua_State* L);
+	static int luaGameGetAutosendLatencyStats(lua_State* L);
 	static int luaGameGetMonsterTypes(lua_State* L);
 	static int luaGameGetBestiary(lua_State* L);
 	static int luaGameGetCurrencyItems(lua_State* L);
@@ -607,6 +610,8 @@ private:
 
 	static int luaCreatureGetStorageValue(lua_State* L);
 	static int luaCreatureSetStorageValue(lua_State* L);
+	static int luaCreatureGetStorageValues(lua_State* L);
+	static int luaCreatureSetStorageValues(lua_State* L);
 
 	// Player
 	static int luaPlayerCreate(lua_State* L);
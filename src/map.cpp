@@ -512,12 +512,12 @@ bool Map::isTileClear(uint16_t x, uint16_t y, uint8_t z, bool blockFloor /*= fal
 	}
 
 	if (pathfinding) {
-		return !tile->hasProperty(CONST_PROP_BLOCKPROJECTILE) && !tile->hasProperty(CONST_PROP_BLOCKPATH) &&
-		       !tile->hasProperty(CONST_PROP_BLOCKSOLID) && !tile->hasProperty(CONST_PROP_IMMOVABLEBLOCKPATH) &&
-		       !tile->hasProperty(CONST_PROP_IMMOVABLEBLOCKSOLID) && !tile->getTopCreature();
+		return !tile->hasFlag(TILESTATE_BLOCKPROJECTILE | TILESTATE_BLOCKPATH | TILESTATE_BLOCKSOLID |
+		                      TILESTATE_IMMOVABLEBLOCKPATH | TILESTATE_IMMOVABLEBLOCKSOLID) &&
+		       !tile->getTopCreature();
 	}
 
-	return !tile->hasProperty(CONST_PROP_BLOCKPROJECTILE);
+	return !tile->hasFlag(TILESTATE_BLOCKPROJECTILE);
 }
 
 namespace {
@@ -32,6 +32,19 @@ MatrixArea MatrixArea::rotate270() const
 	return {{centerY, cols - centerX - 1}, cols, rows, std::move(newArr)};
 }
 
+void MatrixArea::compileRowMasks()
+{
+	rowWords = (cols + 63) / 64;
+	rowMasks.assign(rows * rowWords, 0);
+	for (uint32_t row = 0; row < rows; ++row) {
+		for (uint32_t col = 0; col < cols; ++col) {
+			if (arr[row * cols + col]) {
+				rowMasks[row * rowWords + col / 64] |= uint64_t{1} << (col % 64);
+			}
+		}
+	}
+}
+
 MatrixArea createArea(const std::vector<uint32_t>& vec, uint32_t rows)
 {
 	uint32_t cols;
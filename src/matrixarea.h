@@ -23,6 +23,12 @@ public:
 	[[nodiscard]] MatrixArea rotate180() const;
 	[[nodiscard]] MatrixArea rotate270() const;
 
+	// packs the cells into per-row bitsets, so walking the area only visits the set cells. Must be called again after
+	// the cells are modified.
+	void compileRowMasks();
+	uint32_t getRowWords() const { return rowWords; }
+	uint64_t getRowMask(uint32_t row, uint32_t word) const { return rowMasks[row * rowWords + word]; }
+
 	operator bool() const { return rows == 0 || cols == 0; }
 
 private:
@@ -33,6 +39,9 @@ private:
 	Container arr = {};
 	Center center = {};
 	uint32_t rows = 0, cols = 0;
+
+	std::vector<uint64_t> rowMasks = {};
+	uint32_t rowWords = 0;
 };
 
 MatrixArea createArea(const std::vector<uint32_t>& vec, uint32_t rows);
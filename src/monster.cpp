@@ -497,51 +497,38 @@ void Monster::onCreatureLeave(Creature* creature)
 
 bool Monster::searchTarget(TargetSearchType_t searchType /*= TARGETSEARCH_DEFAULT*/)
 {
-	std::list<Creature*> resultList;
 	const Position& myPos = getPosition();
 
-	for (Creature* creature : targetList) {
-		if (followCreature != creature && isTarget(creature)) {
-			if (searchType == TARGETSEARCH_RANDOM || canUseAttack(myPos, creature)) {
-				resultList.push_back(creature);
-			}
-		}
-	}
-
 	switch (searchType) {
 		case TARGETSEARCH_NEAREST: {
+			// nearest target we can attack from here, falling back to the nearest target at all; the sight check in
+			// canUseAttack only runs for candidates closer than the best one found so far
 			Creature* target = nullptr;
-			if (!resultList.empty()) {
-				auto it = resultList.begin();
-				target = *it;
-
-				if (++it != resultList.end()) {
-					const Position& targetPosition = target->getPosition();
-					int32_t minRange = myPos.getDistanceX(targetPosition) + myPos.getDistanceY(targetPosition);
-					do {
-						const Position& pos = (*it)->getPosition();
-
-						if (int32_t distance = myPos.getDistanceX(pos) + myPos.getDistanceY(pos); distance < minRange) {
-							target = *it;
-							minRange = distance;
-						}
-					} while (++it != resultList.end());
+			Creature* attackableTarget = nullptr;
+			int32_t minRange = std::numeric_limits<int32_t>::max();
+			int32_t minAttackableRange = std::numeric_limits<int32_t>::max();
+			for (Creature* creature : targetList) {
+				if (!isTarget(creature)) {
+					continue;
 				}
-			} else {
-				int32_t minRange = std::numeric_limits<int32_t>::max();
-				for (Creature* creature : targetList) {
-					if (!isTarget(creature)) {
-						continue;
-					}
 
-					const Position& pos = creature->getPosition();
-					if (int32_t distance = myPos.getDistanceX(pos) + myPos.getDistanceY(pos); distance < minRange) {
-						target = creature;
-						minRange = distance;
-					}
+				const Position& pos = creature->getPosition();
+				int32_t distance = myPos.getDistanceX(pos) + myPos.getDistanceY(pos);
+				if (distance < minAttackableRange && followCreature != creature && canUseAttack(myPos, creature)) {
+					attackableTarget = creature;
+					minAttackableRange = distance;
+				}
+
+				if (distance < minRange) {
+					target = creature;
+					minRange = distance;
 				}
 			}
 
+			if (attackableTarget) {
+				target = attackableTarget;
+			}
+
 			if (target && selectTarget(target)) {
 				return true;
 			}
@@ -552,10 +539,25 @@ bool Monster::searchTarget(TargetSearchType_t searchType /*= TARGETSEARCH_DEFAUL
 		case TARGETSEARCH_ATTACKRANGE:
 		case TARGETSEARCH_RANDOM:
 		default: {
-			if (!resultList.empty()) {
-				auto it = resultList.begin();
-				std::advance(it, uniform_random(0, resultList.size() - 1));
-				return selectTarget(*it);
+			// pick uniformly among the candidates without collecting them first (reservoir sampling)
+			Creature* target = nullptr;
+			int32_t candidates = 0;
+			for (Creature* creature : targetList) {
+				if (followCreature == creature || !isTarget(creature)) {
+					continue;
+				}
+
+				if (searchType != TARGETSEARCH_RANDOM && !canUseAttack(myPos, creature)) {
+					continue;
+				}
+
+				if (uniform_random(1, ++candidates) == 1) {
+					target = creature;
+				}
+			}
+
+			if (target) {
+				return selectTarget(target);
 			}
 
 			if (searchType == TARGETSEARCH_ATTACKRANGE) {
@@ -719,9 +721,11 @@ void Monster::updateIdleStatus()
 {
 	bool idle = false;
 	if (!isSummon() && targetList.empty()) {
-		// check if there are aggressive conditions
-		idle = std::find_if(conditions.begin(), conditions.end(),
-		                    [](Condition* condition) { return condition->isAggressive(); }) == conditions.end();
+		// sleeping monsters are not in the think lists and do not execute their conditions, so stay awake until
+		// every aggressive or timed condition has run out
+		idle = std::none_of(conditions.begin(), conditions.end(), [](Condition* condition) {
+			return condition->isAggressive() || condition->getTicks() != -1;
+		});
 	}
 
 	setIdle(idle);
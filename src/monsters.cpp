@@ -1513,7 +1513,7 @@ bool Monsters::loadLootItem(const pugi::xml_node& node, LootBlock& lootBlock)
 
 	} else if ((attr = node.attribute("name"))) {
 		auto name = attr.as_string();
-		auto ids = Item::items.nameToItems.equal_range(boost::algorithm::to_lower_copy<std::string>(name));
+		auto ids = Item::items.nameToItems.equal_range(std::string_view{name});
 
 		if (ids.first == Item::items.nameToItems.cend()) {
 			std::cout << "[Warning - Monsters::loadMonster] Unknown loot item \"" << name << "\". " << std::endl;
@@ -1590,15 +1590,13 @@ void Monsters::loadLootContainer(const pugi::xml_node& node, LootBlock& lBlock)
 
 MonsterType* Monsters::getMonsterType(const std::string& name, bool loadFromFile /*= true */)
 {
-	std::string lowerCaseName = boost::algorithm::to_lower_copy(name);
-
-	auto it = monsters.find(lowerCaseName);
+	auto it = monsters.find(name);
 	if (it == monsters.end()) {
 		if (!loadFromFile) {
 			return nullptr;
 		}
 
-		auto it2 = unloadedMonsters.find(lowerCaseName);
+		auto it2 = unloadedMonsters.find(name);
 		if (it2 == unloadedMonsters.end()) {
 			return nullptr;
 		}
@@ -6,6 +6,7 @@
 
 #include "const.h"
 #include "enums.h"
+#include "tools.h"
 
 class ConditionDamage;
 class LuaScriptInterface;
@@ -261,7 +262,7 @@ public:
 	bool isValidBestiaryInfo(const BestiaryInfo& bestiaryInfo) const;
 
 	std::unique_ptr<LuaScriptInterface> scriptInterface;
-	std::map<std::string, MonsterType> monsters;
+	std::map<std::string, MonsterType, CaseInsensitiveLess> monsters;
 	std::map<std::string, std::set<std::string>> bestiary;
 
 private:
@@ -274,7 +275,7 @@ private:
 	void loadLootContainer(const pugi::xml_node& node, LootBlock&);
 	bool loadLootItem(const pugi::xml_node& node, LootBlock&);
 
-	std::map<std::string, std::string> unloadedMonsters;
+	std::map<std::string, std::string, CaseInsensitiveLess> unloadedMonsters;
 	std::unordered_map<uint32_t, std::string> bestiaryMonsters;
 
 	bool loaded = false;
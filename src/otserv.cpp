@@ -88,6 +88,7 @@ void mainLoader(ServiceManager* services)
 		std::ifstream key{"key.pem"};
 		std::string pem{std::istreambuf_iterator<char>{key}, std::istreambuf_iterator<char>{}};
 		tfs::rsa::loadPEM(pem);
+		tfs::rsa::startWorkers();
 	} catch (const std::exception& e) {
 		startupErrorMessage(e.what());
 		return;
@@ -279,6 +280,7 @@ void startServer()
 	g_scheduler.join();
 	g_databaseTasks.join();
 	g_dispatcher.join();
+	tfs::rsa::joinWorkers();
 }
 
 void printServerVersion()
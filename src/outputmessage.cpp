@@ -5,7 +5,7 @@
 
 #include "outputmessage.h"
 
-#include "lockfree.h"
+#include "configmanager.h"
 #include "protocol.h"
 #include "scheduler.h"
 
@@ -13,58 +13,221 @@ extern Scheduler g_scheduler;
 
 namespace {
 
-const uint16_t OUTPUTMESSAGE_FREE_LIST_CAPACITY = 2048;
-const std::chrono::milliseconds OUTPUTMESSAGE_AUTOSEND_DELAY{10};
+// blocks kept by the shared pool, every thread also keeps up to OUTPUTMESSAGE_CACHE_CAPACITY for itself and trades
+// them with the shared pool OUTPUTMESSAGE_CACHE_BATCH at a time
+constexpr size_t OUTPUTMESSAGE_POOL_CAPACITY = 2048;
+constexpr size_t OUTPUTMESSAGE_CACHE_CAPACITY = 64;
+constexpr size_t OUTPUTMESSAGE_CACHE_BATCH = 32;
 
-// NOTE: A vector is used here because this container is mostly read and relatively rarely modified (only when a
-// client connects/disconnects)
-std::vector<Protocol_ptr> bufferedProtocols;
+// protocols that have buffered messages since the last send, a protocol is in here as long as it has a current buffer
+std::vector<Protocol_ptr> pendingProtocols;
+int64_t lastSendTime = 0;
+bool sendScheduled = false;
 
-void sendAll(const std::vector<Protocol_ptr>& protocols);
+tfs::net::AutosendLatencyStats latencyStats = {};
 
-void scheduleSendAll(const std::vector<Protocol_ptr>& protocols)
-{
-	g_scheduler.addEvent(createSchedulerTask(OUTPUTMESSAGE_AUTOSEND_DELAY.count(), [&]() { sendAll(protocols); }));
-}
-
-void sendAll(const std::vector<Protocol_ptr>& protocols)
+void sendAll()
 {
 	// dispatcher thread
-	for (auto& protocol : protocols) {
+	auto now = std::chrono::steady_clock::now();
+	for (auto& protocol : pendingProtocols) {
+		if (!protocol->isAutosendEnabled()) {
+			continue;
+		}
+
 		if (auto& msg = protocol->getCurrentBuffer()) {
 			protocol->send(std::move(msg));
+
+			auto receiveTime = protocol->takeAnsweredReceiveTime();
+			if (receiveTime != std::chrono::steady_clock::time_point{}) {
+				uint64_t latency = std::chrono::duration_cast<std::chrono::microseconds>(now - receiveTime).count();
+				++latencyStats.samples;
+				latencyStats.totalMicroseconds += latency;
+				latencyStats.maxMicroseconds = std::max(latencyStats.maxMicroseconds, latency);
+			}
 		}
 	}
 
-	if (!protocols.empty()) {
-		scheduleSendAll(protocols);
-	}
+	pendingProtocols.clear();
+	lastSendTime = OTSYS_TIME();
 }
 
+std::atomic<uint64_t> poolHits = 0;
+std::atomic<uint64_t> poolMisses = 0;
+std::atomic<uint64_t> liveMessages = 0;
+std::atomic<uint64_t> peakLiveMessages = 0;
+
+/*
+ * Output messages are created by the dispatcher and released by the network thread once they have been written, so
+ * blocks flow from one thread to the other. Each thread allocates from and releases to a cache of its own, which
+ * only takes the lock of the shared pool when it runs empty or full and then moves a whole batch at once.
+ */
+template <size_t BlockSize>
+class BlockPool
+{
+public:
+	static BlockPool& get()
+	{
+		static BlockPool pool;
+		return pool;
+	}
+
+	void* allocate()
+	{
+		auto& cache = getCache();
+		if (cache.blocks.empty()) {
+			std::lock_guard<std::mutex> lockClass(lock);
+			size_t count = std::min(blocks.size(), OUTPUTMESSAGE_CACHE_BATCH);
+			cache.blocks.insert(cache.blocks.end(), blocks.end() - count, blocks.end());
+			blocks.resize(blocks.size() - count);
+		}
+
+		void* p;
+		if (!cache.blocks.empty()) {
+			p = cache.blocks.back();
+			cache.blocks.pop_back();
+			poolHits.fetch_add(1, std::memory_order_relaxed);
+		} else {
+			// Acquire memory without calling the constructor of T
+			p = operator new(BlockSize);
+			poolMisses.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		uint64_t live = liveMessages.fetch_add(1, std::memory_order_relaxed) + 1;
+		uint64_t peak = peakLiveMessages.load(std::memory_order_relaxed);
+		while (live > peak && !peakLiveMessages.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+		}
+		return p;
+	}
+
+	void deallocate(void* p)
+	{
+		liveMessages.fetch_sub(1, std::memory_order_relaxed);
+
+		auto& cache = getCache();
+		cache.blocks.push_back(p);
+		if (cache.blocks.size() >= OUTPUTMESSAGE_CACHE_CAPACITY) {
+			release(cache.blocks, OUTPUTMESSAGE_CACHE_BATCH);
+		}
+	}
+
+private:
+	struct Cache
+	{
+		Cache() { blocks.reserve(OUTPUTMESSAGE_CACHE_CAPACITY); }
+		~Cache() { BlockPool::get().release(blocks, blocks.size()); }
+
+		std::vector<void*> blocks;
+	};
+
+	BlockPool() { blocks.reserve(OUTPUTMESSAGE_POOL_CAPACITY); }
+
+	static Cache& getCache()
+	{
+		thread_local Cache cache;
+		return cache;
+	}
+
+	// moves the last count blocks of the cache to the shared pool, or frees them once it is full
+	void release(std::vector<void*>& cacheBlocks, size_t count)
+	{
+		auto first = cacheBlocks.end() - count;
+		{
+			std::lock_guard<std::mutex> lockClass(lock);
+			size_t kept = std::min(count, OUTPUTMESSAGE_POOL_CAPACITY - blocks.size());
+			blocks.insert(blocks.end(), first, first + kept);
+			first += kept;
+		}
+
+		// Release memory without calling the destructor of T (it has already been called at this point)
+		std::for_each(first, cacheBlocks.end(), [](void* p) { operator delete(p); });
+		cacheBlocks.resize(cacheBlocks.size() - count);
+	}
+
+	std::mutex lock;
+	std::vector<void*> blocks;
+};
+
+template <typename T>
+class OutputMessageAllocator
+{
+public:
+	using value_type = T;
+
+	OutputMessageAllocator() = default;
+
+	template <typename U>
+	constexpr OutputMessageAllocator(const OutputMessageAllocator<U>&)
+	{}
+
+	T* allocate(size_t n) const
+	{
+		assert(n == 1);
+		return static_cast<T*>(BlockPool<sizeof(T)>::get().allocate());
+	}
+
+	void deallocate(T* p, size_t) const { BlockPool<sizeof(T)>::get().deallocate(p); }
+
+	template <typename U>
+	bool operator==(const OutputMessageAllocator<U>&) const
+	{
+		return true;
+	}
+};
+
 } // namespace
 
 OutputMessage_ptr tfs::net::make_output_message()
 {
-	// LockfreePoolingAllocator<void,...> will leave (void* allocate) ill-formed because of sizeof(T), so this
-	// guarantees that only one list will be initialized
-	return std::allocate_shared<OutputMessage>(LockfreePoolingAllocator<void, OUTPUTMESSAGE_FREE_LIST_CAPACITY>());
+	// the control block is allocated along with the message, so only one pool is ever instantiated
+	return std::allocate_shared<OutputMessage>(OutputMessageAllocator<OutputMessage>());
+}
+
+tfs::net::OutputMessagePoolStats tfs::net::get_output_message_pool_stats()
+{
+	return {poolHits.load(std::memory_order_relaxed), poolMisses.load(std::memory_order_relaxed),
+	        liveMessages.load(std::memory_order_relaxed), peakLiveMessages.load(std::memory_order_relaxed)};
 }
 
 void tfs::net::insert_protocol_to_autosend(const Protocol_ptr& protocol)
 {
 	// dispatcher thread
-	if (bufferedProtocols.empty()) {
-		scheduleSendAll(bufferedProtocols);
+	protocol->setAutosendEnabled(true);
+	if (protocol->getCurrentBuffer()) {
+		pendingProtocols.emplace_back(protocol);
 	}
-	bufferedProtocols.emplace_back(protocol);
 }
 
 void tfs::net::remove_protocol_from_autosend(const Protocol_ptr& protocol)
 {
 	// dispatcher thread
-	auto it = std::find(bufferedProtocols.begin(), bufferedProtocols.end(), protocol);
-	if (it != bufferedProtocols.end()) {
-		std::swap(*it, bufferedProtocols.back());
-		bufferedProtocols.pop_back();
+	// NOTE: a pending entry is skipped by the next send, this keeps removal constant time
+	protocol->setAutosendEnabled(false);
+}
+
+void tfs::net::mark_protocol_for_autosend(const Protocol_ptr& protocol)
+{
+	// dispatcher thread
+	pendingProtocols.emplace_back(protocol);
+}
+
+void tfs::net::send_autosend_messages()
+{
+	// dispatcher thread
+	if (pendingProtocols.empty() || sendScheduled) {
+		return;
 	}
+
+	// with a coalesce time, messages of several batches in a row are sent together
+	int64_t wait = lastSendTime + getNumber(ConfigManager::AUTOSEND_COALESCE_TIME) - OTSYS_TIME();
+	if (wait > 0) {
+		sendScheduled = true;
+		// the messages go out after the batch that runs this task
+		g_scheduler.addEvent(createSchedulerTask(wait, []() { sendScheduled = false; }));
+		return;
+	}
+
+	sendAll();
 }
+
+tfs::net::AutosendLatencyStats tfs::net::get_autosend_latency_stats() { return latencyStats; }
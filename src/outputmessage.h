@@ -60,9 +60,32 @@ public:
 
 namespace tfs::net {
 
+struct OutputMessagePoolStats
+{
+	uint64_t hits;   // messages allocated from a pooled block
+	uint64_t misses; // messages that needed a new block
+	uint64_t live;
+	uint64_t peak; // most messages alive at once
+};
+
 OutputMessage_ptr make_output_message();
+OutputMessagePoolStats get_output_message_pool_stats();
 void insert_protocol_to_autosend(const Protocol_ptr& protocol);
 void remove_protocol_from_autosend(const Protocol_ptr& protocol);
+void mark_protocol_for_autosend(const Protocol_ptr& protocol);
+
+// Sends the messages buffered by the tasks the dispatcher has just run, called after every batch of tasks.
+void send_autosend_messages();
+
+struct AutosendLatencyStats
+{
+	uint64_t samples;
+	uint64_t totalMicroseconds;
+	uint64_t maxMicroseconds;
+};
+
+// time between receiving a packet that buffered messages and sending those messages
+AutosendLatencyStats get_autosend_latency_stats();
 
 } // namespace tfs::net
 
@@ -716,6 +716,11 @@ void Player::setStorageValue(uint32_t key, std::optional<int32_t> value, bool is
 	}
 
 	Creature::setStorageValue(key, value, isSpawn);
+
+	// values loaded from the database are already stored, only track what has to be written back
+	if (!isSpawn) {
+		modifiedStorageKeys.insert(key);
+	}
 }
 
 bool Player::canSee(const Position& pos) const
@@ -1209,6 +1209,7 @@ private:
 
 	std::unordered_set<uint32_t> attackedSet;
 	std::unordered_set<uint32_t> VIPList;
+	std::unordered_set<uint32_t> modifiedStorageKeys;
 
 	std::array<OpenContainer, PLAYER_MAX_OPEN_CONTAINERS> openContainers;
 	std::map<uint32_t, DepotChest_ptr> depotChests;
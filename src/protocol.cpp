@@ -6,7 +6,7 @@
 #include "protocol.h"
 
 #include "outputmessage.h"
-#include "rsa.h"
+#include "tasks.h"
 #include "xtea.h"
 
 namespace {
@@ -114,14 +114,33 @@ void Protocol::onRecvMessage(NetworkMessage& msg)
 		}
 	}
 
+	auto receiveTime = std::chrono::steady_clock::now();
 	parsePacket(msg);
+
+	std::lock_guard<std::mutex> lockClass(receivedPacketLock);
+	receivedPacketTime = receiveTime;
+	receivedPacketLastTask = g_dispatcher.getLastTaskNumber();
+	hasReceivedPacket.store(true, std::memory_order_relaxed);
 }
 
 OutputMessage_ptr Protocol::getOutputBuffer(int32_t size)
 {
 	// dispatcher thread
+	if (hasReceivedPacket.load(std::memory_order_relaxed)) {
+		// the messages answer the last packet as long as the tasks that packet queued have not all run yet
+		std::lock_guard<std::mutex> lockClass(receivedPacketLock);
+		if (answeredReceiveTime == std::chrono::steady_clock::time_point{} &&
+		    g_dispatcher.getCurrentTaskNumber() <= receivedPacketLastTask) {
+			answeredReceiveTime = receivedPacketTime;
+		}
+		hasReceivedPacket.store(false, std::memory_order_relaxed);
+	}
+
 	if (!outputBuffer) {
 		outputBuffer = tfs::net::make_output_message();
+		if (autosendEnabled) {
+			tfs::net::mark_protocol_for_autosend(shared_from_this());
+		}
 	} else if (!outputBuffer->canAdd(size)) {
 		send(outputBuffer);
 		outputBuffer = tfs::net::make_output_message();
@@ -129,16 +148,6 @@ OutputMessage_ptr Protocol::getOutputBuffer(int32_t size)
 	return outputBuffer;
 }
 
-bool Protocol::RSA_decrypt(NetworkMessage& msg)
-{
-	if (msg.getRemainingLength() < RSA_BUFFER_LENGTH) {
-		return false;
-	}
-
-	tfs::rsa::decrypt(msg.getRemainingBuffer(), RSA_BUFFER_LENGTH);
-	return msg.getByte() == 0;
-}
-
 bool Protocol::deflateMessage(OutputMessage& msg)
 {
 	uint8_t *outputBuffer = msg.getOutputBuffer();
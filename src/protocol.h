@@ -37,6 +37,12 @@ public:
 
 	OutputMessage_ptr& getCurrentBuffer() { return outputBuffer; }
 
+	bool isAutosendEnabled() const { return autosendEnabled; }
+	void setAutosendEnabled(bool enabled) { autosendEnabled = enabled; }
+
+	// when the packet answered by the current buffer was received, zero if there is none
+	std::chrono::steady_clock::time_point takeAnsweredReceiveTime() { return std::exchange(answeredReceiveTime, {}); }
+
 	void send(OutputMessage_ptr msg) const
 	{
 		if (auto connection = getConnection()) {
@@ -67,8 +73,6 @@ protected:
 	void setXTEAKey(const xtea::key& key) { this->key = xtea::expand_key(key); }
 	void setChecksumMode(checksumMode_t newMode) { checksumMode = newMode; }
 
-	static bool RSA_decrypt(NetworkMessage& msg);
-
 	bool deflateMessage(OutputMessage& msg);
 
 	void setRawMessages(bool value) { rawMessages = value; }
@@ -86,6 +90,15 @@ private:
 	bool encryptionEnabled = false;
 	checksumMode_t checksumMode = CHECKSUM_ADLER;
 	bool rawMessages = false;
+	bool autosendEnabled = false;
+	std::chrono::steady_clock::time_point answeredReceiveTime;
+
+	// the last packet received and the number of the last dispatcher task it may have queued, written by the
+	// network thread
+	std::mutex receivedPacketLock;
+	std::atomic<bool> hasReceivedPacket = false;
+	std::chrono::steady_clock::time_point receivedPacketTime;
+	uint64_t receivedPacketLastTask = 0;
 
 	z_stream zstream{};
 };
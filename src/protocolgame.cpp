@@ -20,6 +20,8 @@
 #include "outputmessage.h"
 #include "player.h"
 #include "podium.h"
+#include "ratelimit.h"
+#include "rsa.h"
 #include "scheduler.h"
 #include "storeinbox.h"
 #include "tasks.h"
@@ -29,6 +31,12 @@ extern Chat* g_chat;
 
 namespace {
 
+// every address may start this many logins at once, then one more per interval (ms)
+constexpr uint32_t LOGIN_RATE_BURST = 10;
+constexpr int64_t LOGIN_RATE_INTERVAL = 1000;
+
+RateLimiter loginLimiter;
+
 std::deque<std::pair<int64_t, uint32_t>> waitList; // (timeout, player guid)
 auto priorityEnd = waitList.end();
 
@@ -136,6 +144,89 @@ ClientDamageType getClientDamageType(CombatType_t combatType)
 	}
 }
 
+// The part of a tile description that is the same for every player: the serialized ground and top items, and the
+// down items as far as they can make it into the stack. Only the creatures in between depend on the viewer.
+struct TileItemsDescription
+{
+	const Tile* tile = nullptr;
+	uint32_t version = 0;
+	int32_t topItemCount = 0;
+	std::vector<uint8_t> topItems;
+	std::vector<uint8_t> downItems;
+	std::vector<uint16_t> downItemEnds;
+};
+
+// Descriptions of recently described tiles, shared by all players. An entry is only reused while the tile keeps the
+// version it was made from, and a tile is replaced by whatever other tile maps to the same entry.
+std::array<TileItemsDescription, 16384> tileItemsCache;
+
+// Items that show charges, a running duration or the state of a container or podium change without the tile being
+// updated
+bool isItemDescriptionCacheable(const Item* item)
+{
+	const ItemType& it = Item::items[item->getID()];
+	return !it.showClientCharges && !it.showClientDuration && !it.isPodium() && it.weaponType != WEAPON_QUIVER;
+}
+
+bool describeTileItems(const Tile* tile, TileItemsDescription& description)
+{
+	static NetworkMessage msg;
+	bool cacheable = true;
+
+	msg.wrpos = 0;
+	description.topItemCount = 0;
+
+	if (Item* ground = tile->getGround()) {
+		msg.addItem(ground);
+		cacheable = cacheable && isItemDescriptionCacheable(ground);
+		++description.topItemCount;
+	}
+
+	const TileItemVector* items = tile->getItemList();
+	if (items) {
+		for (auto it = items->getBeginTopItem(), end = items->getEndTopItem();
+		     it != end && description.topItemCount < MAX_STACKPOS; ++it) {
+			msg.addItem(*it);
+			cacheable = cacheable && isItemDescriptionCacheable(*it);
+			++description.topItemCount;
+		}
+	}
+	description.topItems.assign(msg.buffer.data(), msg.buffer.data() + msg.wrpos);
+
+	msg.wrpos = 0;
+	description.downItemEnds.clear();
+
+	if (items) {
+		for (auto it = items->getBeginDownItem(), end = items->getEndDownItem();
+		     it != end && description.topItemCount + description.downItemEnds.size() < MAX_STACKPOS; ++it) {
+			msg.addItem(*it);
+			cacheable = cacheable && isItemDescriptionCacheable(*it);
+			description.downItemEnds.push_back(msg.wrpos);
+		}
+	}
+	description.downItems.assign(msg.buffer.data(), msg.buffer.data() + msg.wrpos);
+	return cacheable;
+}
+
+const TileItemsDescription& getTileItemsDescription(const Tile* tile)
+{
+	auto address = reinterpret_cast<uintptr_t>(tile);
+	auto& description = tileItemsCache[(address >> 4) * 11400714819323198485ull >> 50];
+	if (description.tile == tile && description.version == tile->getVersion()) {
+		return description;
+	}
+
+	if (describeTileItems(tile, description)) {
+		description.tile = tile;
+		description.version = tile->getVersion();
+		return description;
+	}
+
+	// the entry now holds the description of a tile that must not be cached
+	description.tile = nullptr;
+	return description;
+}
+
 } // namespace
 
 void ProtocolGame::release()
@@ -173,19 +264,7 @@ void ProtocolGame::login(uint32_t characterId, uint32_t accountId, OperatingSyst
 			return;
 		}
 
-		if (g_game.getGameState() == GAME_STATE_CLOSING && !player->hasFlag(PlayerFlag_CanAlwaysLogin)) {
-			disconnectClient("The game is just going down.\nPlease try again later.");
-			return;
-		}
-
-		if (g_game.getGameState() == GAME_STATE_CLOSED && !player->hasFlag(PlayerFlag_CanAlwaysLogin)) {
-			disconnectClient("Server is currently closed.\nPlease try again later.");
-			return;
-		}
-
-		if (getBoolean(ConfigManager::ONE_PLAYER_ON_ACCOUNT) && player->getAccountType() < ACCOUNT_TYPE_GAMEMASTER &&
-		    g_game.getPlayerByAccount(player->getAccount())) {
-			disconnectClient("You may only login with one character\nof your account at the same time.");
+		if (!canJoinGame()) {
 			return;
 		}
 
@@ -204,60 +283,133 @@ void ProtocolGame::login(uint32_t characterId, uint32_t accountId, OperatingSyst
 			}
 		}
 
-		if (std::size_t currentSlot = clientLogin(*player)) {
-			uint8_t retryTime = getWaitTime(currentSlot);
-			auto output = tfs::net::make_output_message();
-			output->addByte(0x16);
-			output->addString(
-			    fmt::format("Too many players online.\nYou are at place {:d} on the waiting list.", currentSlot));
-			output->addByte(retryTime);
-			send(output);
-
-			disconnect();
+		if (!checkWaitingList()) {
 			return;
 		}
 
-		if (!IOLoginData::loadPlayerById(player, player->getGUID())) {
-			disconnectClient("Your character could not be loaded.");
-			return;
-		}
+		// the character is loaded from results fetched on the database thread, the login continues once they arrive
+		IOLoginData::fetchPlayerById(player->getGUID(), player->getAccount(),
+		                             [=, thisPtr = getThis()](IOLoginData::PlayerResults results) {
+			                             thisPtr->finishLogin(results, operatingSystem);
+		                             });
+	} else {
+		relogin(foundPlayer, operatingSystem);
+	}
+}
 
-		player->setOperatingSystem(operatingSystem);
+bool ProtocolGame::canJoinGame()
+{
+	// dispatcher thread
+	if (g_game.getGameState() == GAME_STATE_CLOSING && !player->hasFlag(PlayerFlag_CanAlwaysLogin)) {
+		disconnectClient("The game is just going down.\nPlease try again later.");
+		return false;
+	}
 
-		if (!g_game.placeCreature(player, player->getLoginPosition(), false, false, CONST_ME_TELEPORT)) {
-			if (!g_game.placeCreature(player, player->getTemplePosition(), false, true, CONST_ME_TELEPORT)) {
-				disconnectClient("Temple position is wrong. Contact the administrator.");
-				return;
-			}
-		}
+	if (g_game.getGameState() == GAME_STATE_CLOSED && !player->hasFlag(PlayerFlag_CanAlwaysLogin)) {
+		disconnectClient("Server is currently closed.\nPlease try again later.");
+		return false;
+	}
 
-		if (operatingSystem >= CLIENTOS_OTCLIENT_LINUX) {
-			player->registerCreatureEvent("ExtendedOpcode");
-		}
+	if (getBoolean(ConfigManager::ONE_PLAYER_ON_ACCOUNT) && player->getAccountType() < ACCOUNT_TYPE_GAMEMASTER &&
+	    g_game.getPlayerByAccount(player->getAccount())) {
+		disconnectClient("You may only login with one character\nof your account at the same time.");
+		return false;
+	}
+	return true;
+}
+
+bool ProtocolGame::checkWaitingList()
+{
+	// dispatcher thread
+	std::size_t currentSlot = clientLogin(*player);
+	if (currentSlot == 0) {
+		return true;
+	}
+
+	uint8_t retryTime = getWaitTime(currentSlot);
+	auto output = tfs::net::make_output_message();
+	output->addByte(0x16);
+	output->addString(fmt::format("Too many players online.\nYou are at place {:d} on the waiting list.", currentSlot));
+	output->addByte(retryTime);
+	send(output);
+
+	disconnect();
+	return false;
+}
+
+void ProtocolGame::relogin(Player* foundPlayer, OperatingSystem_t operatingSystem)
+{
+	// dispatcher thread
+	if (eventConnect != 0 || !getBoolean(ConfigManager::REPLACE_KICK_ON_LOGIN)) {
+		// Already trying to connect
+		disconnectClient("You are already logged in.");
+		return;
+	}
+
+	if (foundPlayer->client) {
+		foundPlayer->disconnect();
+		foundPlayer->isConnecting = true;
 
-		player->lastIP = player->getIP();
-		player->lastLoginSaved = std::max<time_t>(time(nullptr), player->lastLoginSaved + 1);
-		acceptPackets = true;
+		eventConnect =
+		    g_scheduler.addEvent(createSchedulerTask(1000, [=, thisPtr = getThis(), playerID = foundPlayer->getID()]() {
+			    thisPtr->connect(playerID, operatingSystem);
+		    }));
 	} else {
-		if (eventConnect != 0 || !getBoolean(ConfigManager::REPLACE_KICK_ON_LOGIN)) {
-			// Already trying to connect
-			disconnectClient("You are already logged in.");
+		connect(foundPlayer->getID(), operatingSystem);
+	}
+
+	tfs::net::insert_protocol_to_autosend(shared_from_this());
+}
+
+void ProtocolGame::finishLogin(const IOLoginData::PlayerResults& results, OperatingSystem_t operatingSystem)
+{
+	// dispatcher thread
+	if (isConnectionExpired() || !player) {
+		// the client went away while the character was being fetched, release() has already dropped the player
+		return;
+	}
+
+	// another login of the same character may have finished in the meantime, that one is now replaced as if it had
+	// been online already
+	if (!getBoolean(ConfigManager::ALLOW_CLONES)) {
+		if (Player* foundPlayer = g_game.getPlayerByGUID(player->getGUID())) {
+			player->client.reset();
+			player->decrementReferenceCounter();
+			player = nullptr;
+
+			relogin(foundPlayer, operatingSystem);
 			return;
 		}
+	}
 
-		if (foundPlayer->client) {
-			foundPlayer->disconnect();
-			foundPlayer->isConnecting = true;
+	// the game state, the online characters of the account and the number of players may all have changed while the
+	// character was being fetched
+	if (!canJoinGame() || !checkWaitingList()) {
+		return;
+	}
 
-			eventConnect = g_scheduler.addEvent(
-			    createSchedulerTask(1000, [=, thisPtr = getThis(), playerID = foundPlayer->getID()]() {
-				    thisPtr->connect(playerID, operatingSystem);
-			    }));
-		} else {
-			connect(foundPlayer->getID(), operatingSystem);
+	if (!IOLoginData::loadPlayer(player, results)) {
+		disconnectClient("Your character could not be loaded.");
+		return;
+	}
+
+	player->setOperatingSystem(operatingSystem);
+
+	if (!g_game.placeCreature(player, player->getLoginPosition(), false, false, CONST_ME_TELEPORT)) {
+		if (!g_game.placeCreature(player, player->getTemplePosition(), false, true, CONST_ME_TELEPORT)) {
+			disconnectClient("Temple position is wrong. Contact the administrator.");
+			return;
 		}
 	}
 
+	if (operatingSystem >= CLIENTOS_OTCLIENT_LINUX) {
+		player->registerCreatureEvent("ExtendedOpcode");
+	}
+
+	player->lastIP = player->getIP();
+	player->lastLoginSaved = std::max<time_t>(time(nullptr), player->lastLoginSaved + 1);
+	acceptPackets = true;
+
 	tfs::net::insert_protocol_to_autosend(shared_from_this());
 }
 
@@ -365,8 +517,33 @@ void ProtocolGame::onRecvFirstMessage(NetworkMessage& msg)
 	msg.get<uint16_t>(); // dat revision
 	msg.getByte();       // preview state
 
+	if (!loginLimiter.consume(getIP(), LOGIN_RATE_INTERVAL, LOGIN_RATE_BURST)) {
+		addConnectionDrop(CONNECTION_DROP_LOGIN_RATE);
+		disconnect();
+		return;
+	}
+
+	auto connection = getConnection();
+	if (!connection || msg.getRemainingLength() < RSA_BUFFER_LENGTH) {
+		disconnect();
+		return;
+	}
+
+	// the message is decrypted by a crypto worker, the connection leaves it alone until the login continues
+	connection->pauseRead();
+	auto onDecrypted = [=, &msg, thisPtr = getThis()]() {
+		connection->resumeRead([=, &msg]() { thisPtr->onRecvLoginMessage(msg, operatingSystem); });
+	};
+	if (!tfs::rsa::decryptAsync(msg.getRemainingBuffer(), RSA_BUFFER_LENGTH, std::move(onDecrypted))) {
+		addConnectionDrop(CONNECTION_DROP_LOGIN_BACKLOG);
+		disconnect();
+	}
+}
+
+void ProtocolGame::onRecvLoginMessage(NetworkMessage& msg, OperatingSystem_t operatingSystem)
+{
 	// Disconnect if RSA decrypt fails
-	if (!Protocol::RSA_decrypt(msg)) {
+	if (msg.getByte() != 0) {
 		disconnect();
 		return;
 	}
@@ -501,6 +678,8 @@ void ProtocolGame::writeToOutputBuffer(const NetworkMessage& msg)
 	out->append(msg);
 }
 
+OutputMessage& ProtocolGame::startSmallPacket() { return *getOutputBuffer(SMALL_PACKET_MAXSIZE); }
+
 void ProtocolGame::parsePacket(NetworkMessage& msg)
 {
 	if (!acceptPackets || g_game.getGameState() == GAME_STATE_SHUTDOWN || !msg.canRead(1)){
@@ -809,25 +988,9 @@ void ProtocolGame::parsePacket(NetworkMessage& msg)
 
 void ProtocolGame::GetTileDescription(const Tile* tile, NetworkMessage& msg)
 {
-	int32_t count;
-	Item* ground = tile->getGround();
-	if (ground) {
-		msg.addItem(ground);
-		count = 1;
-	} else {
-		count = 0;
-	}
-
-	const TileItemVector* items = tile->getItemList();
-	if (items) {
-		for (auto it = items->getBeginTopItem(), end = items->getEndTopItem(); it != end; ++it) {
-			msg.addItem(*it);
-
-			if (++count == MAX_STACKPOS) {
-				break;
-			}
-		}
-	}
+	const auto& items = getTileItemsDescription(tile);
+	msg.addBytes(items.topItems.data(), items.topItems.size());
+	int32_t count = items.topItemCount;
 
 	const CreatureVector* creatures = tile->getCreatures();
 	if (creatures) {
@@ -845,14 +1008,9 @@ void ProtocolGame::GetTileDescription(const Tile* tile, NetworkMessage& msg)
 		}
 	}
 
-	if (items && count < MAX_STACKPOS) {
-		for (auto it = items->getBeginDownItem(), end = items->getEndDownItem(); it != end; ++it) {
-			msg.addItem(*it);
-
-			if (++count == MAX_STACKPOS) {
-				return;
-			}
-		}
+	if (count < MAX_STACKPOS && !items.downItemEnds.empty()) {
+		size_t downItemCount = std::min<size_t>(MAX_STACKPOS - count, items.downItemEnds.size());
+		msg.addBytes(items.downItems.data(), items.downItemEnds[downItemCount - 1]);
 	}
 }
 
@@ -909,36 +1067,14 @@ void ProtocolGame::GetFloorDescription(NetworkMessage& msg, int32_t x, int32_t y
 
 void ProtocolGame::checkCreatureAsKnown(uint32_t id, bool& known, uint32_t& removedKnown)
 {
-	auto result = knownCreatureSet.insert(id);
-	if (!result.second) {
+	if (knownCreatures.contains(id)) {
 		known = true;
 		return;
 	}
 
 	known = false;
-
-	if (knownCreatureSet.size() > 1300) {
-		// Look for a creature to remove
-		for (auto it = knownCreatureSet.begin(), end = knownCreatureSet.end(); it != end; ++it) {
-			Creature* creature = g_game.getCreatureByID(*it);
-			if (!canSee(creature)) {
-				removedKnown = *it;
-				knownCreatureSet.erase(it);
-				return;
-			}
-		}
-
-		// Bad situation. Let's just remove anyone.
-		auto it = knownCreatureSet.begin();
-		if (*it == id) {
-			++it;
-		}
-
-		removedKnown = *it;
-		knownCreatureSet.erase(it);
-	} else {
-		removedKnown = 0;
-	}
+	removedKnown =
+	    knownCreatures.insert(id, [this](uint32_t knownId) { return !canSee(g_game.getCreatureByID(knownId)); });
 }
 
 bool ProtocolGame::canSee(const Creature* c) const
@@ -1620,14 +1756,13 @@ void ProtocolGame::sendCreatureLight(const Creature* creature)
 		return;
 	}
 
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0x8D);
 	msg.add<uint32_t>(creature->getID());
 
 	auto&& [level, color] = creature->getCreatureLight();
 	msg.addByte((player->isAccessPlayer() ? 0xFF : level));
 	msg.addByte(color);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendCreatureWalkthrough(const Creature* creature, bool walkthrough)
@@ -1636,11 +1771,10 @@ void ProtocolGame::sendCreatureWalkthrough(const Creature* creature, bool walkth
 		return;
 	}
 
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0x92);
 	msg.add<uint32_t>(creature->getID());
 	msg.addByte(walkthrough ? 0x00 : 0x01);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendCreatureShield(const Creature* creature)
@@ -1649,11 +1783,10 @@ void ProtocolGame::sendCreatureShield(const Creature* creature)
 		return;
 	}
 
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0x91);
 	msg.add<uint32_t>(creature->getID());
 	msg.addByte(player->getPartyShield(creature->getPlayer()));
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendCreatureSkull(const Creature* creature)
@@ -1666,11 +1799,10 @@ void ProtocolGame::sendCreatureSkull(const Creature* creature)
 		return;
 	}
 
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0x90);
 	msg.add<uint32_t>(creature->getID());
 	msg.addByte(player->getSkullClient(creature));
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendCreatureSquare(const Creature* creature, SquareColor_t color)
@@ -1679,20 +1811,18 @@ void ProtocolGame::sendCreatureSquare(const Creature* creature, SquareColor_t co
 		return;
 	}
 
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0x93);
 	msg.add<uint32_t>(creature->getID());
 	msg.addByte(0x01);
 	msg.addByte(color);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendTutorial(uint8_t tutorialId)
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0xDC);
 	msg.addByte(tutorialId);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendAddMarker(const Position& pos, uint8_t markType, const std::string& desc)
@@ -1708,12 +1838,11 @@ void ProtocolGame::sendAddMarker(const Position& pos, uint8_t markType, const st
 
 void ProtocolGame::sendReLoginWindow(uint8_t unfairFightReduction)
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0x28);
 	msg.addByte(0x00);
 	msg.addByte(unfairFightReduction);
 	msg.addByte(0x00); // can use death redemption (bool)
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendStats()
@@ -1725,11 +1854,10 @@ void ProtocolGame::sendStats()
 
 void ProtocolGame::sendExperienceTracker(int64_t rawExp, int64_t finalExp)
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0xAF);
 	msg.add<int64_t>(rawExp);
 	msg.add<int64_t>(finalExp);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendClientFeatures()
@@ -1824,10 +1952,9 @@ void ProtocolGame::sendTextMessage(const TextMessage& message)
 
 void ProtocolGame::sendClosePrivate(uint16_t channelId)
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0xB3);
 	msg.add<uint16_t>(channelId);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendCreatePrivateChannel(uint16_t channelId, const std::string& channelName)
@@ -1902,10 +2029,9 @@ void ProtocolGame::sendChannelMessage(const std::string& author, const std::stri
 
 void ProtocolGame::sendIcons(uint32_t icons)
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0xA2);
 	msg.add<uint32_t>(icons);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendContainer(uint8_t cid, const Container* container, uint16_t firstIndex)
@@ -1993,9 +2119,8 @@ void ProtocolGame::sendShop(Npc* npc, const ShopInfoList& itemList)
 
 void ProtocolGame::sendCloseShop()
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0x7C);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendSaleItemList(const std::list<ShopInfo>& shop)
@@ -2084,16 +2209,15 @@ void ProtocolGame::sendSaleItemList(const std::list<ShopInfo>& shop)
 
 void ProtocolGame::sendResourceBalance(const ResourceTypes_t resourceType, uint64_t amount)
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0xEE);
 	msg.addByte(resourceType);
 	msg.add<uint64_t>(amount);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendStoreBalance()
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0xDF);
 	msg.addByte(0x01);
 
@@ -2102,7 +2226,6 @@ void ProtocolGame::sendStoreBalance()
 	msg.add<uint32_t>(0); // transferable store coins
 	msg.add<uint32_t>(0); // reserved auction coins
 	msg.add<uint32_t>(0); // tournament coins
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendMarketEnter()
@@ -2172,9 +2295,8 @@ void ProtocolGame::sendMarketEnter()
 
 void ProtocolGame::sendMarketLeave()
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0xF7);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendMarketBrowseItem(uint16_t itemId, const MarketOfferList& buyOffers,
@@ -2278,7 +2400,7 @@ void ProtocolGame::sendMarketBrowseOwnOffers(const MarketOfferList& buyOffers, c
 
 void ProtocolGame::sendMarketCancelOffer(const MarketOfferEx& offer)
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0xF9);
 	msg.addByte(MARKETREQUEST_OWN_OFFERS);
 
@@ -2305,8 +2427,6 @@ void ProtocolGame::sendMarketCancelOffer(const MarketOfferEx& offer)
 		msg.add<uint16_t>(offer.amount);
 		msg.add<uint64_t>(offer.price);
 	}
-
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendMarketBrowseOwnHistory(const HistoryMarketOfferList& buyOffers,
@@ -2396,17 +2516,15 @@ void ProtocolGame::sendTradeItemRequest(const std::string& traderName, const Ite
 
 void ProtocolGame::sendCloseTrade()
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0x7F);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendCloseContainer(uint8_t cid)
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0x6F);
 	msg.addByte(cid);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendCreatureTurn(const Creature* creature, uint32_t stackpos)
@@ -2415,7 +2533,7 @@ void ProtocolGame::sendCreatureTurn(const Creature* creature, uint32_t stackpos)
 		return;
 	}
 
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0x6B);
 	if (stackpos >= MAX_STACKPOS) {
 		msg.add<uint16_t>(0xFFFF);
@@ -2429,7 +2547,6 @@ void ProtocolGame::sendCreatureTurn(const Creature* creature, uint32_t stackpos)
 	msg.add<uint32_t>(creature->getID());
 	msg.addByte(creature->getDirection());
 	msg.addByte(player->canWalkthroughEx(creature) ? 0x00 : 0x01);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendCreatureSay(const Creature* creature, SpeakClasses type, const std::string& text,
@@ -2512,28 +2629,25 @@ void ProtocolGame::sendPrivateMessage(const Player* speaker, SpeakClasses type,
 
 void ProtocolGame::sendCancelTarget()
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0xA3);
 	msg.add<uint32_t>(0x00);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendChangeSpeed(const Creature* creature, uint32_t speed)
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0x8F);
 	msg.add<uint32_t>(creature->getID());
 	msg.add<uint16_t>(creature->getBaseSpeed() / 2);
 	msg.add<uint16_t>(speed / 2);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendCancelWalk()
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0xB5);
 	msg.addByte(player->getDirection());
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendSkills()
@@ -2545,21 +2659,19 @@ void ProtocolGame::sendSkills()
 
 void ProtocolGame::sendPing()
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0x1D);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendPingBack()
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0x1E);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendDistanceShoot(const Position& from, const Position& to, uint8_t type)
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0x83);
 	msg.addPosition(from);
 	msg.addByte(MAGIC_EFFECTS_CREATE_DISTANCEEFFECT);
@@ -2567,7 +2679,6 @@ void ProtocolGame::sendDistanceShoot(const Position& from, const Position& to, u
 	msg.addByte(static_cast<uint8_t>(static_cast<int8_t>(static_cast<int32_t>(to.x) - static_cast<int32_t>(from.x))));
 	msg.addByte(static_cast<uint8_t>(static_cast<int8_t>(static_cast<int32_t>(to.y) - static_cast<int32_t>(from.y))));
 	msg.addByte(MAGIC_EFFECTS_END_LOOP);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendMagicEffect(const Position& pos, uint8_t type)
@@ -2576,18 +2687,17 @@ void ProtocolGame::sendMagicEffect(const Position& pos, uint8_t type)
 		return;
 	}
 
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0x83);
 	msg.addPosition(pos);
 	msg.addByte(MAGIC_EFFECTS_CREATE_EFFECT);
 	msg.addByte(type);
 	msg.addByte(MAGIC_EFFECTS_END_LOOP);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendCreatureHealth(const Creature* creature)
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0x8C);
 	msg.add<uint32_t>(creature->getID());
 
@@ -2597,7 +2707,6 @@ void ProtocolGame::sendCreatureHealth(const Creature* creature)
 		msg.addByte(std::ceil(
 		    (static_cast<double>(creature->getHealth()) / std::max<int32_t>(creature->getMaxHealth(), 1)) * 100));
 	}
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendFYIBox(const std::string& message)
@@ -2625,12 +2734,11 @@ void ProtocolGame::sendAddTileItem(const Position& pos, uint32_t stackpos, const
 		return;
 	}
 
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0x6A);
 	msg.addPosition(pos);
 	msg.addByte(stackpos);
 	msg.addItem(item);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendUpdateTileItem(const Position& pos, uint32_t stackpos, const Item* item)
@@ -2639,12 +2747,11 @@ void ProtocolGame::sendUpdateTileItem(const Position& pos, uint32_t stackpos, co
 		return;
 	}
 
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0x6B);
 	msg.addPosition(pos);
 	msg.addByte(stackpos);
 	msg.addItem(item);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendRemoveTileThing(const Position& pos, uint32_t stackpos)
@@ -2653,9 +2760,8 @@ void ProtocolGame::sendRemoveTileThing(const Position& pos, uint32_t stackpos)
 		return;
 	}
 
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	RemoveTileThing(msg, pos, stackpos);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendUpdateTileCreature(const Position& pos, uint32_t stackpos, const Creature* creature)
@@ -2736,27 +2842,24 @@ void ProtocolGame::sendUpdateCreatureIcons(const Creature* creature)
 
 void ProtocolGame::sendPendingStateEntered()
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0x0A);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendEnterWorld()
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0x0F);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendFightModes()
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0xA7);
 	msg.addByte(player->fightMode);
 	msg.addByte(player->chaseMode);
 	msg.addByte(player->secureMode);
 	msg.addByte(PVP_MODE_DOVE);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendAddCreature(const Creature* creature, const Position& pos, int32_t stackpos,
@@ -2853,7 +2956,7 @@ void ProtocolGame::sendMoveCreature(const Creature* creature, const Position& ne
 			sendRemoveTileCreature(creature, oldPos, oldStackPos);
 			sendAddCreature(creature, newPos, newStackPos);
 		} else {
-			NetworkMessage msg;
+			auto& msg = startSmallPacket();
 			msg.addByte(0x6D);
 			if (oldStackPos < MAX_STACKPOS) {
 				msg.addPosition(oldPos);
@@ -2863,7 +2966,6 @@ void ProtocolGame::sendMoveCreature(const Creature* creature, const Position& ne
 				msg.add<uint32_t>(creature->getID());
 			}
 			msg.addPosition(creature->getPosition());
-			writeToOutputBuffer(msg);
 		}
 	} else if (canSee(oldPos)) {
 		sendRemoveTileCreature(creature, oldPos, oldStackPos);
@@ -2874,7 +2976,7 @@ void ProtocolGame::sendMoveCreature(const Creature* creature, const Position& ne
 
 void ProtocolGame::sendInventoryItem(slots_t slot, const Item* item)
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	if (item) {
 		msg.addByte(0x78);
 		msg.addByte(slot);
@@ -2883,7 +2985,6 @@ void ProtocolGame::sendInventoryItem(slots_t slot, const Item* item)
 		msg.addByte(0x79);
 		msg.addByte(slot);
 	}
-	writeToOutputBuffer(msg);
 }
 
 // to do: make it lightweight, update each time player gets/loses an item
@@ -2914,7 +3015,7 @@ void ProtocolGame::sendItems()
 
 void ProtocolGame::sendAddContainerItem(uint8_t cid, uint16_t slot, const Item* item)
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0x70);
 	msg.addByte(cid);
 	msg.add<uint16_t>(slot);
@@ -2923,22 +3024,20 @@ void ProtocolGame::sendAddContainerItem(uint8_t cid, uint16_t slot, const Item*
 	}else{
 		msg.add<uint16_t>(0x00);
 	}
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendUpdateContainerItem(uint8_t cid, uint16_t slot, const Item* item)
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0x71);
 	msg.addByte(cid);
 	msg.add<uint16_t>(slot);
 	msg.addItem(item);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendRemoveContainerItem(uint8_t cid, uint16_t slot, const Item* lastItem)
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0x72);
 	msg.addByte(cid);
 	msg.add<uint16_t>(slot);
@@ -2947,7 +3046,6 @@ void ProtocolGame::sendRemoveContainerItem(uint8_t cid, uint16_t slot, const Ite
 	} else {
 		msg.add<uint16_t>(0x00);
 	}
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendTextWindow(uint32_t windowTextId, Item* item, uint16_t maxlen, bool canWrite)
@@ -3262,11 +3360,10 @@ void ProtocolGame::sendPodiumWindow(const Item* item)
 
 void ProtocolGame::sendUpdatedVIPStatus(uint32_t guid, VipStatus_t newStatus)
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0xD3);
 	msg.add<uint32_t>(guid);
 	msg.addByte(newStatus);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendVIP(uint32_t guid, const std::string& name, const std::string& description, uint32_t icon,
@@ -3332,37 +3429,32 @@ void ProtocolGame::sendItemClasses()
 
 void ProtocolGame::sendSpellCooldown(uint8_t spellId, uint32_t time)
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0xA4);
 	msg.add<uint16_t>(static_cast<uint16_t>(spellId));
 	msg.add<uint32_t>(time);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendSpellGroupCooldown(SpellGroup_t groupId, uint32_t time)
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0xA5);
 	msg.addByte(groupId);
 	msg.add<uint32_t>(time);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendUseItemCooldown(uint32_t time)
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0xA6);
 	msg.add<uint32_t>(time);
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendSupplyUsed(const uint16_t clientId)
 {
-	NetworkMessage msg;
+	auto& msg = startSmallPacket();
 	msg.addByte(0xCE);
 	msg.add<uint16_t>(clientId);
-
-	writeToOutputBuffer(msg);
 }
 
 void ProtocolGame::sendModalWindow(const ModalWindow& modalWindow)
@@ -6,6 +6,8 @@
 
 #include "chat.h"
 #include "creature.h"
+#include "iologindata.h"
+#include "knowncreatures.h"
 #include "protocol.h"
 #include "tasks.h"
 
@@ -65,6 +67,7 @@ public:
 	explicit ProtocolGame(Connection_ptr connection) : Protocol(connection) {}
 
 	void login(uint32_t characterId, uint32_t accountId, OperatingSystem_t operatingSystem);
+	void finishLogin(const IOLoginData::PlayerResults& results, OperatingSystem_t operatingSystem);
 	void logout(bool displayEffect, bool forced);
 
 	uint16_t getVersion() const { return version; }
@@ -72,9 +75,20 @@ public:
 private:
 	ProtocolGame_ptr getThis() { return std::static_pointer_cast<ProtocolGame>(shared_from_this()); }
 	void connect(uint32_t playerId, OperatingSystem_t operatingSystem);
+	// both disconnect the client with the reason when it may not enter the game
+	bool canJoinGame();
+	bool checkWaitingList();
+	void relogin(Player* foundPlayer, OperatingSystem_t operatingSystem);
 	void disconnectClient(const std::string& message) const;
 	void writeToOutputBuffer(const NetworkMessage& msg);
 
+	// packets made only of fixed-size fields and at most one item never exceed this size
+	static constexpr int32_t SMALL_PACKET_MAXSIZE = 128;
+
+	// returns the pending output message, replaced first if a small packet might not fit anymore, so that such
+	// packets are encoded straight into it instead of being staged in a NetworkMessage and copied
+	OutputMessage& startSmallPacket();
+
 	void release() override;
 
 	void checkCreatureAsKnown(uint32_t id, bool& known, uint32_t& removedKnown);
@@ -86,6 +100,7 @@ private:
 	// we have all the parse methods
 	void parsePacket(NetworkMessage& msg) override;
 	void onRecvFirstMessage(NetworkMessage& msg) override;
+	void onRecvLoginMessage(NetworkMessage& msg, OperatingSystem_t operatingSystem);
 	void onConnect() override;
 
 	// Parse methods
@@ -313,7 +328,7 @@ private:
 
 	friend class Player;
 
-	std::unordered_set<uint32_t> knownCreatureSet;
+	KnownCreatures knownCreatures;
 	Player* player = nullptr;
 
 	uint32_t eventConnect = 0;
@@ -8,12 +8,12 @@
 #include "configmanager.h"
 #include "game.h"
 #include "outputmessage.h"
+#include "ratelimit.h"
 
 #include <ranges>
 
 extern Game g_game;
 
-std::map<Connection::Address, int64_t> ProtocolStatus::ipConnectMap;
 const uint64_t ProtocolStatus::start = OTSYS_TIME();
 
 enum RequestedInfo_t : uint16_t
@@ -28,59 +28,66 @@ enum RequestedInfo_t : uint16_t
 	REQUEST_SERVER_SOFTWARE_INFO = 1 << 7,
 };
 
-void ProtocolStatus::onRecvFirstMessage(NetworkMessage& msg)
+struct StatusSnapshot
 {
-	const static auto acceptorAddress = boost::asio::ip::make_address(getString(ConfigManager::IP));
+	int64_t expiresAt;
+	uint32_t playersOnline;
+	uint32_t playersRecord;
+	uint32_t mapWidth;
+	uint32_t mapHeight;
+	// name and level of every online player, sorted case-insensitively by name
+	std::vector<std::pair<std::string, uint32_t>> players;
+	std::string statusString;
+};
 
-	const auto& ip = getIP();
+namespace {
 
-	if (!ip.is_loopback() && ip != acceptorAddress) {
-		if (auto it = ipConnectMap.find(ip);
-		    it != ipConnectMap.end() && (OTSYS_TIME() < (it->second + getNumber(ConfigManager::STATUSQUERY_TIMEOUT)))) {
-			disconnect();
-			return;
-		}
-	}
+using StatusSnapshot_ptr = std::shared_ptr<const StatusSnapshot>;
 
-	ipConnectMap[ip] = OTSYS_TIME();
+// one status request per statusTimeout and address
+RateLimiter statusLimiter;
 
-	switch (msg.getByte()) {
-		// XML info protocol
-		case 0xFF: {
-			if (msg.getString(4) == "info") {
-				g_dispatcher.addTask([thisPtr = std::static_pointer_cast<ProtocolStatus>(shared_from_this())]() {
-					thisPtr->sendStatusString();
-				});
-				return;
-			}
-			break;
-		}
+// written by the dispatcher, read by the network threads to answer status requests without posting a task
+StatusSnapshot_ptr currentSnapshot;
+std::mutex currentSnapshotLock;
 
-		// Another ServerInfo protocol
-		case 0x01: {
-			uint16_t requestedInfo = msg.get<uint16_t>(); // only a Byte is necessary, though we could add new info here
-			std::string characterName;
-			if (requestedInfo & REQUEST_PLAYER_STATUS_INFO) {
-				characterName = msg.getString();
-			}
-			g_dispatcher.addTask(
-			    [=, thisPtr = std::static_pointer_cast<ProtocolStatus>(shared_from_this()),
-			     characterName = std::move(characterName)]() { thisPtr->sendInfo(requestedInfo, characterName); });
-			return;
-		}
+StatusSnapshot_ptr getStatusSnapshot()
+{
+	StatusSnapshot_ptr snapshot;
+	{
+		std::lock_guard<std::mutex> lockClass(currentSnapshotLock);
+		snapshot = currentSnapshot;
+	}
 
-		default:
-			break;
+	if (!snapshot || OTSYS_TIME() >= snapshot->expiresAt) {
+		return nullptr;
 	}
-	disconnect();
+	return snapshot;
 }
 
-void ProtocolStatus::sendStatusString()
+uint32_t getReportableOnlinePlayerCount()
 {
-	auto output = tfs::net::make_output_message();
+	uint32_t maxPlayersPerIp = getNumber(ConfigManager::STATUS_COUNT_MAX_PLAYERS_PER_IP);
+	if (maxPlayersPerIp == 0) {
+		return g_game.getPlayersOnline();
+	}
 
-	setRawMessages(true);
+	std::map<Connection::Address, uint32_t> playersPerIp;
+	for (const auto& it : g_game.getPlayers()) {
+		if (!it.second->getIP().is_unspecified()) {
+			++playersPerIp[it.second->getIP()];
+		}
+	}
 
+	uint32_t reportableOnlinePlayerCount = 0;
+	for (auto& p : playersPerIp | std::views::values) {
+		reportableOnlinePlayerCount += std::min(p, maxPlayersPerIp);
+	}
+	return reportableOnlinePlayerCount;
+}
+
+std::string buildStatusString(const StatusSnapshot& snapshot)
+{
 	pugi::xml_document doc;
 
 	pugi::xml_node decl = doc.prepend_child(pugi::node_declaration);
@@ -106,27 +113,9 @@ void ProtocolStatus::sendStatusString()
 	owner.append_attribute("email") = getString(ConfigManager::OWNER_EMAIL).c_str();
 
 	pugi::xml_node players = tsqp.append_child("players");
-
-	uint32_t reportableOnlinePlayerCount = 0;
-	uint32_t maxPlayersPerIp = getNumber(ConfigManager::STATUS_COUNT_MAX_PLAYERS_PER_IP);
-	if (maxPlayersPerIp > 0) {
-		std::map<Connection::Address, uint32_t> playersPerIp;
-		for (const auto& it : g_game.getPlayers()) {
-			if (!it.second->getIP().is_unspecified()) {
-				++playersPerIp[it.second->getIP()];
-			}
-		}
-
-		for (auto& p : playersPerIp | std::views::values) {
-			reportableOnlinePlayerCount += std::min(p, maxPlayersPerIp);
-		}
-	} else {
-		reportableOnlinePlayerCount = g_game.getPlayersOnline();
-	}
-
-	players.append_attribute("online") = std::to_string(reportableOnlinePlayerCount).c_str();
+	players.append_attribute("online") = std::to_string(getReportableOnlinePlayerCount()).c_str();
 	players.append_attribute("max") = std::to_string(getNumber(ConfigManager::MAX_PLAYERS)).c_str();
-	players.append_attribute("peak") = std::to_string(g_game.getPlayersRecord()).c_str();
+	players.append_attribute("peak") = std::to_string(snapshot.playersRecord).c_str();
 
 	pugi::xml_node monsters = tsqp.append_child("monsters");
 	monsters.append_attribute("total") = std::to_string(g_game.getMonstersOnline()).c_str();
@@ -144,25 +133,117 @@ void ProtocolStatus::sendStatusString()
 	pugi::xml_node map = tsqp.append_child("map");
 	map.append_attribute("name") = getString(ConfigManager::MAP_NAME).c_str();
 	map.append_attribute("author") = getString(ConfigManager::MAP_AUTHOR).c_str();
-
-	uint32_t mapWidth, mapHeight;
-	g_game.getMapDimensions(mapWidth, mapHeight);
-	map.append_attribute("width") = std::to_string(mapWidth).c_str();
-	map.append_attribute("height") = std::to_string(mapHeight).c_str();
+	map.append_attribute("width") = std::to_string(snapshot.mapWidth).c_str();
+	map.append_attribute("height") = std::to_string(snapshot.mapHeight).c_str();
 
 	pugi::xml_node motd = tsqp.append_child("motd");
 	motd.text() = "N/A";
 
 	std::ostringstream ss;
 	doc.save(ss, "", pugi::format_raw);
+	return ss.str();
+}
+
+// must be called from the dispatcher, recomputes the snapshot once the previous one expired
+StatusSnapshot_ptr updateStatusSnapshot()
+{
+	if (auto snapshot = getStatusSnapshot()) {
+		return snapshot;
+	}
+
+	auto snapshot = std::make_shared<StatusSnapshot>();
+	snapshot->expiresAt = OTSYS_TIME() + getNumber(ConfigManager::STATUS_CACHE_TIME);
+	snapshot->playersOnline = g_game.getPlayersOnline();
+	snapshot->playersRecord = g_game.getPlayersRecord();
+	g_game.getMapDimensions(snapshot->mapWidth, snapshot->mapHeight);
+
+	const auto& players = g_game.getPlayers();
+	snapshot->players.reserve(players.size());
+	for (const auto& it : players) {
+		snapshot->players.emplace_back(it.second->getName(), it.second->getLevel());
+	}
+	std::ranges::sort(snapshot->players, CaseInsensitiveLess{},
+	                  [](const auto& player) -> std::string_view { return player.first; });
+
+	snapshot->statusString = buildStatusString(*snapshot);
+
+	{
+		std::lock_guard<std::mutex> lockClass(currentSnapshotLock);
+		currentSnapshot = snapshot;
+	}
+	return snapshot;
+}
+
+} // namespace
+
+void ProtocolStatus::onRecvFirstMessage(NetworkMessage& msg)
+{
+	const static auto acceptorAddress = boost::asio::ip::make_address(getString(ConfigManager::IP));
+
+	const auto& ip = getIP();
+
+	if (!ip.is_loopback() && ip != acceptorAddress &&
+	    !statusLimiter.consume(ip, getNumber(ConfigManager::STATUSQUERY_TIMEOUT), 1)) {
+		addConnectionDrop(CONNECTION_DROP_STATUS_RATE);
+		disconnect();
+		return;
+	}
+
+	switch (msg.getByte()) {
+		// XML info protocol
+		case 0xFF: {
+			if (msg.getString(4) == "info") {
+				if (auto snapshot = getStatusSnapshot()) {
+					sendStatusString(*snapshot);
+					return;
+				}
+
+				g_dispatcher.addTask([thisPtr = std::static_pointer_cast<ProtocolStatus>(shared_from_this())]() {
+					thisPtr->sendStatusString(*updateStatusSnapshot());
+				});
+				return;
+			}
+			break;
+		}
+
+		// Another ServerInfo protocol
+		case 0x01: {
+			uint16_t requestedInfo = msg.get<uint16_t>(); // only a Byte is necessary, though we could add new info here
+			std::string characterName;
+			if (requestedInfo & REQUEST_PLAYER_STATUS_INFO) {
+				characterName = msg.getString();
+			}
+
+			if (auto snapshot = getStatusSnapshot()) {
+				sendInfo(requestedInfo, characterName, *snapshot);
+				return;
+			}
+
+			g_dispatcher.addTask([=, thisPtr = std::static_pointer_cast<ProtocolStatus>(shared_from_this()),
+			                      characterName = std::move(characterName)]() {
+				thisPtr->sendInfo(requestedInfo, characterName, *updateStatusSnapshot());
+			});
+			return;
+		}
+
+		default:
+			break;
+	}
+	disconnect();
+}
+
+void ProtocolStatus::sendStatusString(const StatusSnapshot& snapshot)
+{
+	auto output = tfs::net::make_output_message();
+
+	setRawMessages(true);
 
-	std::string data = ss.str();
-	output->addBytes((const uint8_t*)data.data(), data.size());
+	output->addBytes(reinterpret_cast<const uint8_t*>(snapshot.statusString.data()), snapshot.statusString.size());
 	send(output);
 	disconnect();
 }
 
-void ProtocolStatus::sendInfo(uint16_t requestedInfo, const std::string& characterName)
+void ProtocolStatus::sendInfo(uint16_t requestedInfo, const std::string& characterName, const StatusSnapshot& snapshot)
 {
 	auto output = tfs::net::make_output_message();
 
@@ -189,35 +270,33 @@ void ProtocolStatus::sendInfo(uint16_t requestedInfo, const std::string& charact
 
 	if (requestedInfo & REQUEST_PLAYERS_INFO) {
 		output->addByte(0x20);
-		output->add<uint32_t>(g_game.getPlayersOnline());
+		output->add<uint32_t>(snapshot.playersOnline);
 		output->add<uint32_t>(getNumber(ConfigManager::MAX_PLAYERS));
-		output->add<uint32_t>(g_game.getPlayersRecord());
+		output->add<uint32_t>(snapshot.playersRecord);
 	}
 
 	if (requestedInfo & REQUEST_MAP_INFO) {
 		output->addByte(0x30);
 		output->addString(getString(ConfigManager::MAP_NAME));
 		output->addString(getString(ConfigManager::MAP_AUTHOR));
-		uint32_t mapWidth, mapHeight;
-		g_game.getMapDimensions(mapWidth, mapHeight);
-		output->add<uint16_t>(mapWidth);
-		output->add<uint16_t>(mapHeight);
+		output->add<uint16_t>(snapshot.mapWidth);
+		output->add<uint16_t>(snapshot.mapHeight);
 	}
 
 	if (requestedInfo & REQUEST_EXT_PLAYERS_INFO) {
 		output->addByte(0x21); // players info - online players list
 
-		const auto& players = g_game.getPlayers();
-		output->add<uint32_t>(players.size());
-		for (const auto& it : players) {
-			output->addString(it.second->getName());
-			output->add<uint32_t>(it.second->getLevel());
+		output->add<uint32_t>(snapshot.players.size());
+		for (const auto& [name, level] : snapshot.players) {
+			output->addString(name);
+			output->add<uint32_t>(level);
 		}
 	}
 
 	if (requestedInfo & REQUEST_PLAYER_STATUS_INFO) {
 		output->addByte(0x22); // players info - online status info of a player
-		if (g_game.getPlayerByName(characterName)) {
+		if (std::ranges::binary_search(snapshot.players, characterName, CaseInsensitiveLess{},
+		                               [](const auto& player) -> std::string_view { return player.first; })) {
 			output->addByte(0x01);
 		} else {
 			output->addByte(0x00);
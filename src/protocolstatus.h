@@ -7,6 +7,7 @@
 #include "protocol.h"
 
 class NetworkMessage;
+struct StatusSnapshot;
 
 class ProtocolStatus final : public Protocol
 {
@@ -30,13 +31,10 @@ public:
 
 	void onRecvFirstMessage(NetworkMessage& msg) override;
 
-	void sendStatusString();
-	void sendInfo(uint16_t requestedInfo, const std::string& characterName);
+	void sendStatusString(const StatusSnapshot& snapshot);
+	void sendInfo(uint16_t requestedInfo, const std::string& characterName, const StatusSnapshot& snapshot);
 
 	static const uint64_t start;
-
-private:
-	static std::map<Connection::Address, int64_t> ipConnectMap;
 };
 
 #endif // FS_PROTOCOLSTATUS_H
@@ -0,0 +1,74 @@
+// Copyright 2023 The Forgotten Server Authors. All rights reserved.
+// Use of this source code is governed by the GPL-2.0 License that can be found in the LICENSE file.
+
+#include "otpch.h"
+
+#include "ratelimit.h"
+
+#include "tools.h"
+
+RateLimiter g_connectionLimiter;
+
+namespace {
+
+std::array<std::atomic<uint64_t>, CONNECTION_DROP_LAST> connectionDrops = {};
+
+uint64_t getAddressKey(const Connection::Address& address)
+{
+	if (address.is_v4()) {
+		return address.to_v4().to_uint();
+	}
+
+	const auto& v6 = address.to_v6();
+	if (v6.is_v4_mapped()) {
+		return boost::asio::ip::make_address_v4(boost::asio::ip::v4_mapped, v6).to_uint();
+	}
+
+	auto bytes = v6.to_bytes();
+	uint64_t prefix = 0;
+	for (size_t i = 0; i < 8; ++i) {
+		prefix = (prefix << 8) | bytes[i];
+	}
+	return prefix;
+}
+
+// splitmix64 finalizer, spreads consecutive addresses over the whole table
+uint64_t mix(uint64_t key)
+{
+	key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9;
+	key = (key ^ (key >> 27)) * 0x94D049BB133111EB;
+	return key ^ (key >> 31);
+}
+
+} // namespace
+
+RateLimiter::RateLimiter(size_t slotCount) :
+    slots{std::make_unique<std::atomic<int64_t>[]>(std::bit_ceil(slotCount))}, slotMask{std::bit_ceil(slotCount) - 1}
+{}
+
+bool RateLimiter::consume(const Connection::Address& address, int64_t interval, uint32_t burst)
+{
+	return consume(address, interval, burst, OTSYS_TIME());
+}
+
+bool RateLimiter::consume(const Connection::Address& address, int64_t interval, uint32_t burst, int64_t now)
+{
+	auto& slot = slots[mix(getAddressKey(address)) & slotMask];
+
+	int64_t fullAt = slot.load(std::memory_order_relaxed);
+	int64_t newFullAt;
+	do {
+		newFullAt = std::max(fullAt, now) + interval;
+		if (newFullAt - now > interval * std::max<uint32_t>(burst, 1)) {
+			return false;
+		}
+	} while (!slot.compare_exchange_weak(fullAt, newFullAt, std::memory_order_relaxed));
+	return true;
+}
+
+void addConnectionDrop(ConnectionDropReason reason) { connectionDrops[reason].fetch_add(1, std::memory_order_relaxed); }
+
+uint64_t getConnectionDrops(ConnectionDropReason reason)
+{
+	return connectionDrops[reason].load(std::memory_order_relaxed);
+}
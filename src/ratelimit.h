@@ -0,0 +1,58 @@
+// Copyright 2023 The Forgotten Server Authors. All rights reserved.
+// Use of this source code is governed by the GPL-2.0 License that can be found in the LICENSE file.
+
+#ifndef FS_RATELIMIT_H
+#define FS_RATELIMIT_H
+
+#include "connection.h"
+
+// every address may open this many connections at once, then one more per interval (ms)
+static constexpr uint32_t CONNECTION_RATE_BURST = 5;
+static constexpr int64_t CONNECTION_RATE_INTERVAL = 500;
+
+enum ConnectionDropReason : uint8_t
+{
+	CONNECTION_DROP_CONNECTION_RATE,
+	CONNECTION_DROP_STATUS_RATE,
+	CONNECTION_DROP_PACKET_RATE,
+	CONNECTION_DROP_LOGIN_RATE,
+	CONNECTION_DROP_LOGIN_BACKLOG,
+
+	CONNECTION_DROP_LAST /* this must be the last one */
+};
+
+/*
+ * Token buckets keyed by remote address, usable from any thread without locking. The table has a fixed number of
+ * slots; every slot is a single atomic holding the time at which its bucket is full again (GCRA), so a bucket that
+ * has been idle long enough looks exactly like an unused one and nothing ever has to be expired or evicted.
+ * Addresses hashing to the same slot share their bucket. IPv6 addresses are keyed by their /64 prefix, which is what
+ * a single host usually gets.
+ */
+class RateLimiter
+{
+public:
+	explicit RateLimiter(size_t slotCount = 1 << 16);
+
+	// non-copyable
+	RateLimiter(const RateLimiter&) = delete;
+	RateLimiter& operator=(const RateLimiter&) = delete;
+
+	/**
+	 * Takes a token from the bucket of the address.
+	 *
+	 * @param interval milliseconds it takes to refill one token
+	 * @param burst size of the bucket
+	 * @return false if the bucket is empty
+	 */
+	bool consume(const Connection::Address& address, int64_t interval, uint32_t burst);
+	bool consume(const Connection::Address& address, int64_t interval, uint32_t burst, int64_t now);
+
+private:
+	std::unique_ptr<std::atomic<int64_t>[]> slots;
+	size_t slotMask;
+};
+
+void addConnectionDrop(ConnectionDropReason reason);
+uint64_t getConnectionDrops(ConnectionDropReason reason);
+
+#endif // FS_RATELIMIT_H
@@ -23,6 +23,9 @@ using C_ptr = std::unique_ptr<T, Deleter>;
 
 C_ptr<EVP_PKEY> pkey = nullptr;
 
+std::unique_ptr<boost::asio::thread_pool> workers;
+std::atomic<size_t> pendingDecryptions = 0;
+
 } // namespace
 
 namespace tfs::rsa {
@@ -36,6 +39,45 @@ void decrypt(uint8_t* msg, size_t len)
 	EVP_PKEY_decrypt(pctx.get(), msg, &len, msg, len);
 }
 
+void startWorkers()
+{
+	assert(!workers);
+	workers = std::make_unique<boost::asio::thread_pool>(std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u));
+}
+
+void joinWorkers()
+{
+	if (!workers) {
+		return;
+	}
+
+	// decryptions still queued are dropped along with their callbacks
+	workers->stop();
+	workers->join();
+	workers.reset();
+}
+
+bool decryptAsync(uint8_t* msg, size_t len, std::function<void()> callback)
+{
+	if (!workers) {
+		decrypt(msg, len);
+		callback();
+		return true;
+	}
+
+	if (pendingDecryptions.fetch_add(1, std::memory_order_relaxed) >= MAX_PENDING_DECRYPTIONS) {
+		pendingDecryptions.fetch_sub(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	boost::asio::post(*workers, [=, callback = std::move(callback)]() {
+		decrypt(msg, len);
+		pendingDecryptions.fetch_sub(1, std::memory_order_relaxed);
+		callback();
+	});
+	return true;
+}
+
 EVP_PKEY* loadPEM(std::string_view pem)
 {
 	C_ptr<BIO> bio{BIO_new(BIO_s_mem())};
@@ -12,6 +12,21 @@ namespace tfs::rsa {
 EVP_PKEY* loadPEM(std::string_view pem);
 void decrypt(uint8_t* msg, size_t len);
 
+// at most this many decryptions may wait for a crypto worker
+static constexpr size_t MAX_PENDING_DECRYPTIONS = 1024;
+
+// Private key operations are slow, so the network thread hands them to a few threads of their own.
+void startWorkers();
+void joinWorkers();
+
+/**
+ * Decrypts len bytes at msg in place on a crypto worker and then calls callback from that worker. The buffer must
+ * stay alive and untouched until the callback runs. Without workers the message is decrypted right away.
+ *
+ * @return false if too many decryptions are pending, nothing is queued then
+ */
+bool decryptAsync(uint8_t* msg, size_t len, std::function<void()> callback);
+
 } // namespace tfs::rsa
 
 #endif // FS_RSA_H
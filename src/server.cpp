@@ -7,53 +7,13 @@
 
 #include "ban.h"
 #include "configmanager.h"
+#include "ratelimit.h"
 #include "scheduler.h"
 #include "tools.h"
 
-namespace {
-
-struct ConnectBlock
-{
-	uint64_t lastAttempt;
-	uint64_t blockTime = 0;
-	uint32_t count = 1;
-};
-
-bool acceptConnection(const Connection::Address& clientIP)
-{
-	static std::recursive_mutex mu;
-	std::lock_guard lock{mu};
-
-	uint64_t currentTime = OTSYS_TIME();
-
-	static std::map<Connection::Address, ConnectBlock> ipConnectMap;
-	auto it = ipConnectMap.find(clientIP);
-	if (it == ipConnectMap.end()) {
-		ipConnectMap.emplace(clientIP, ConnectBlock{.lastAttempt = currentTime});
-		return true;
-	}
-
-	ConnectBlock& connectBlock = it->second;
-	if (connectBlock.blockTime > currentTime) {
-		connectBlock.blockTime += 250;
-		return false;
-	}
+extern RateLimiter g_connectionLimiter;
 
-	int64_t timeDiff = currentTime - connectBlock.lastAttempt;
-	connectBlock.lastAttempt = currentTime;
-	if (timeDiff <= 5000) {
-		if (++connectBlock.count > 5) {
-			connectBlock.count = 0;
-			if (timeDiff <= 500) {
-				connectBlock.blockTime = currentTime + 3000;
-				return false;
-			}
-		}
-	} else {
-		connectBlock.count = 1;
-	}
-	return true;
-}
+namespace {
 
 boost::asio::ip::address getListenAddress()
 {
@@ -144,16 +104,20 @@ void ServicePort::onAccept(Connection_ptr connection, const boost::system::error
 			return;
 		}
 
-		const auto& remote_ip = connection->getIP();
-		if (acceptConnection(remote_ip)) {
+		boost::system::error_code endpointError;
+		auto endpoint = connection->getSocket().remote_endpoint(endpointError);
+		if (endpointError) {
+			connection->close(Connection::FORCE_CLOSE);
+		} else if (!g_connectionLimiter.consume(endpoint.address(), CONNECTION_RATE_INTERVAL, CONNECTION_RATE_BURST)) {
+			addConnectionDrop(CONNECTION_DROP_CONNECTION_RATE);
+			connection->close(Connection::FORCE_CLOSE);
+		} else {
 			Service_ptr service = services.front();
 			if (service->is_single_socket()) {
 				connection->accept(service->make_protocol(connection));
 			} else {
 				connection->accept();
 			}
-		} else {
-			connection->close(Connection::FORCE_CLOSE);
 		}
 
 		accept();
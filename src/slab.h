@@ -0,0 +1,100 @@
+// Copyright 2023 The Forgotten Server Authors. All rights reserved.
+// Use of this source code is governed by the GPL-2.0 License that can be found in the LICENSE file.
+
+#ifndef FS_SLAB_H
+#define FS_SLAB_H
+
+/*
+ * Pool for the small objects the map is made of (tiles, items, item attributes). Objects are carved out of large chunks
+ * which are never given back to the system, freed slots are kept in an intrusive free list and handed out again. One
+ * pool exists per object size and alignment, so types of the same layout share it. Slots are only padded up to the
+ * alignment of the object, not to the platform maximum.
+ *
+ * Like the game state these objects belong to, the pools must only be used from the dispatcher thread.
+ */
+template <size_t ObjectSize, size_t ObjectAlignment = alignof(std::max_align_t), size_t ObjectsPerChunk = 4096>
+class Slab
+{
+public:
+	static void* allocate()
+	{
+		++liveObjects;
+		if (freeList) {
+			void* p = freeList;
+			freeList = freeList->next;
+			return p;
+		}
+
+		if (cursor == chunkEnd) {
+			cursor = static_cast<char*>(operator new(slotSize * ObjectsPerChunk));
+			chunkEnd = cursor + slotSize * ObjectsPerChunk;
+			++chunks;
+		}
+
+		void* p = cursor;
+		cursor += slotSize;
+		return p;
+	}
+
+	static void deallocate(void* p)
+	{
+		--liveObjects;
+		freeList = new (p) FreeSlot{freeList};
+	}
+
+	static size_t getLiveObjects() { return liveObjects; }
+	static size_t getReservedBytes() { return chunks * slotSize * ObjectsPerChunk; }
+
+private:
+	struct FreeSlot
+	{
+		FreeSlot* next;
+	};
+
+	static constexpr size_t slotAlignment = std::max(ObjectAlignment, alignof(FreeSlot));
+	static constexpr size_t slotSize =
+	    (std::max(ObjectSize, sizeof(FreeSlot)) + slotAlignment - 1) / slotAlignment * slotAlignment;
+
+	static inline FreeSlot* freeList = nullptr;
+	static inline char* cursor = nullptr;
+	static inline char* chunkEnd = nullptr;
+	static inline size_t chunks = 0;
+	static inline size_t liveObjects = 0;
+};
+
+/*
+ * Base class routing allocations of exactly T through its pool. Classes derived from T that do not inherit from
+ * SlabAllocated themselves arrive here with a different size and fall back to the global heap; with a virtual
+ * destructor, operator delete receives the size of the dynamic type. Types of the same layout share a pool, so the
+ * live objects are counted per type here rather than taken from the pool.
+ */
+template <typename T>
+class SlabAllocated
+{
+public:
+	static void* operator new(size_t size)
+	{
+		if (size == sizeof(T)) {
+			++liveObjects;
+			return Slab<sizeof(T), alignof(T)>::allocate();
+		}
+		return ::operator new(size);
+	}
+
+	static void operator delete(void* p, size_t size)
+	{
+		if (size == sizeof(T)) {
+			--liveObjects;
+			Slab<sizeof(T), alignof(T)>::deallocate(p);
+		} else {
+			::operator delete(p);
+		}
+	}
+
+	static size_t getLiveObjects() { return liveObjects; }
+
+private:
+	static inline size_t liveObjects = 0;
+};
+
+#endif // FS_SLAB_H
@@ -20,6 +20,11 @@ extern Game g_game;
 static constexpr int32_t MINSPAWN_INTERVAL = 10 * 1000;           // 10 seconds to match RME
 static constexpr int32_t MAXSPAWN_INTERVAL = 24 * 60 * 60 * 1000; // 1 day
 
+// due spawns are checked together and at most this many monsters are spawned per check, so that a respawn wave
+// (e.g. everything killed during a raid, or all intervals lining up after a restart) is spread over several ticks
+static constexpr int32_t SPAWN_CHECK_INTERVAL = 100;
+static constexpr uint32_t SPAWN_CHECK_BUDGET = 25;
+
 bool Spawns::loadFromXml(const std::string& filename, bool isCalledByLua)
 {
 	pugi::xml_document doc;
@@ -219,9 +224,11 @@ void Spawns::startup()
 
 void Spawns::clear()
 {
-	for (Spawn& spawn : spawnList) {
-		spawn.stopEvent();
+	if (checkSpawnsEvent != 0) {
+		g_scheduler.stopEvent(checkSpawnsEvent);
+		checkSpawnsEvent = 0;
 	}
+	spawnChecks = {};
 	spawnList.clear();
 
 	loaded = false;
@@ -239,10 +246,43 @@ bool Spawns::isInZone(const Position& centerPos, int32_t radius, const Position&
 	        (pos.getY() >= centerPos.getY() - radius) && (pos.getY() <= centerPos.getY() + radius));
 }
 
+void Spawns::scheduleSpawnCheck(Spawn* spawn, int64_t time)
+{
+	spawn->checkScheduled = true;
+	spawnChecks.emplace(time, spawn);
+
+	if (checkSpawnsEvent == 0) {
+		checkSpawnsEvent =
+		    g_scheduler.addEvent(createSchedulerTask(SPAWN_CHECK_INTERVAL, [this]() { checkSpawns(); }));
+	}
+}
+
+void Spawns::checkSpawns()
+{
+	checkSpawnsEvent = 0;
+
+	const int64_t now = OTSYS_TIME();
+	uint32_t budget = SPAWN_CHECK_BUDGET;
+	while (!spawnChecks.empty() && budget > 0) {
+		auto [time, spawn] = spawnChecks.top();
+		if (time > now) {
+			break;
+		}
+
+		spawnChecks.pop();
+		spawn->checkSpawn(budget);
+	}
+
+	if (!spawnChecks.empty()) {
+		int64_t delay = std::max<int64_t>(SPAWN_CHECK_INTERVAL, spawnChecks.top().first - now);
+		checkSpawnsEvent = g_scheduler.addEvent(createSchedulerTask(delay, [this]() { checkSpawns(); }));
+	}
+}
+
 void Spawn::startSpawnCheck()
 {
-	if (checkSpawnEvent == 0) {
-		checkSpawnEvent = g_scheduler.addEvent(createSchedulerTask(getInterval(), [this]() { checkSpawn(); }));
+	if (!checkScheduled) {
+		g_game.map.spawns.scheduleSpawnCheck(this, OTSYS_TIME() + getInterval());
 	}
 }
 
@@ -350,9 +390,9 @@ void Spawn::startup()
 	}
 }
 
-void Spawn::checkSpawn()
+void Spawn::checkSpawn(uint32_t& budget)
 {
-	checkSpawnEvent = 0;
+	checkScheduled = false;
 
 	cleanup();
 
@@ -366,11 +406,18 @@ void Spawn::checkSpawn()
 
 		spawnBlock_t& sb = it.second;
 		if (OTSYS_TIME() >= sb.lastSpawn + sb.interval) {
+			if (budget == 0) {
+				// out of budget for this tick, continue with the next one
+				g_game.map.spawns.scheduleSpawnCheck(this, OTSYS_TIME());
+				return;
+			}
+
 			if (!spawnMonster(spawnId, sb)) {
 				sb.lastSpawn = OTSYS_TIME();
 				continue;
 			}
 
+			--budget;
 			if (++spawnCount >= static_cast<uint32_t>(getNumber(ConfigManager::RATE_SPAWN))) {
 				break;
 			}
@@ -378,7 +425,7 @@ void Spawn::checkSpawn()
 	}
 
 	if (spawnedMap.size() < spawnMap.size()) {
-		checkSpawnEvent = g_scheduler.addEvent(createSchedulerTask(getInterval(), [this]() { checkSpawn(); }));
+		startSpawnCheck();
 	}
 }
 
@@ -433,10 +480,3 @@ void Spawn::removeMonster(Monster* monster)
 	}
 }
 
-void Spawn::stopEvent()
-{
-	if (checkSpawnEvent != 0) {
-		g_scheduler.stopEvent(checkSpawnEvent);
-		checkSpawnEvent = 0;
-	}
-}
@@ -37,7 +37,6 @@ public:
 	void startup();
 
 	void startSpawnCheck();
-	void stopEvent();
 
 	bool isInSpawnZone(const Position& pos);
 	void cleanup();
@@ -54,12 +53,14 @@ private:
 	int32_t radius;
 
 	uint32_t interval = 60000;
-	uint32_t checkSpawnEvent = 0;
+	bool checkScheduled = false;
 
 	static bool findPlayer(const Position& pos);
 	bool spawnMonster(uint32_t spawnId, spawnBlock_t sb, bool startup = false);
 	bool spawnMonster(uint32_t spawnId, MonsterType* mType, const Position& pos, Direction dir, bool startup = false);
-	void checkSpawn();
+	void checkSpawn(uint32_t& budget);
+
+	friend class Spawns;
 };
 
 class Spawns
@@ -73,7 +74,16 @@ public:
 
 	bool isStarted() const { return started; }
 
+	void scheduleSpawnCheck(Spawn* spawn, int64_t time);
+
 private:
+	void checkSpawns();
+
+	// spawns waiting for their next check, earliest first
+	using SpawnCheck = std::pair<int64_t, Spawn*>;
+	std::priority_queue<SpawnCheck, std::vector<SpawnCheck>, std::greater<>> spawnChecks;
+	uint32_t checkSpawnsEvent = 0;
+
 	std::forward_list<Npc*> npcList;
 	std::forward_list<Spawn> spawnList;
 	std::string filename;
@@ -7,6 +7,7 @@
 
 #include "enums.h"
 #include "game.h"
+#include "outputmessage.h"
 
 extern Game g_game;
 
@@ -31,6 +32,7 @@ void Dispatcher::threadMain()
 		taskLockUnique.unlock();
 
 		for (Task* task : tmpTaskList) {
+			++currentTaskNumber;
 			if (!task->hasExpired()) {
 				++dispatcherCycle;
 				// execute it
@@ -39,6 +41,8 @@ void Dispatcher::threadMain()
 			delete task;
 		}
 		tmpTaskList.clear();
+
+		tfs::net::send_autosend_messages();
 	}
 }
 
@@ -51,6 +55,7 @@ void Dispatcher::addTask(Task* task)
 	if (getState() == THREAD_STATE_RUNNING) {
 		do_signal = taskList.empty();
 		taskList.push_back(task);
+		lastTaskNumber.fetch_add(1, std::memory_order_relaxed);
 	} else {
 		delete task;
 	}
@@ -72,6 +77,7 @@ void Dispatcher::shutdown()
 
 	std::lock_guard<std::mutex> lockClass(taskLock);
 	taskList.push_back(task);
+	lastTaskNumber.fetch_add(1, std::memory_order_relaxed);
 
 	taskSignal.notify_one();
 }
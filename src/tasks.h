@@ -57,6 +57,10 @@ public:
 
 	uint64_t getDispatcherCycle() const { return dispatcherCycle; }
 
+	// tasks are numbered as they are added and run in that order
+	uint64_t getLastTaskNumber() const { return lastTaskNumber.load(std::memory_order_relaxed); }
+	uint64_t getCurrentTaskNumber() const { return currentTaskNumber; }
+
 	void threadMain();
 
 private:
@@ -65,6 +69,8 @@ private:
 
 	std::vector<Task*> taskList;
 	uint64_t dispatcherCycle = 0;
+	std::atomic<uint64_t> lastTaskNumber = 0;
+	uint64_t currentTaskNumber = 0;
 };
 
 extern Dispatcher g_dispatcher;
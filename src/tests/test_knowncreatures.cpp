@@ -0,0 +1,76 @@
+#define BOOST_TEST_MODULE knowncreatures
+
+#include "../otpch.h"
+
+#include "../knowncreatures.h"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_CASE(test_knowncreatures_contains_inserted)
+{
+	KnownCreatures knownCreatures;
+	BOOST_TEST(!knownCreatures.contains(0x10000001));
+
+	BOOST_TEST(knownCreatures.insert(0x10000001, [](uint32_t) { return true; }) == 0u);
+	BOOST_TEST(knownCreatures.contains(0x10000001));
+	BOOST_TEST(knownCreatures.size() == 1u);
+}
+
+BOOST_AUTO_TEST_CASE(test_knowncreatures_evicts_when_full)
+{
+	KnownCreatures knownCreatures;
+	for (uint32_t id = 1; id <= KnownCreatures::LIMIT; ++id) {
+		BOOST_TEST(knownCreatures.insert(0x40000000 + id, [](uint32_t) { return true; }) == 0u);
+	}
+	BOOST_TEST(knownCreatures.size() == KnownCreatures::LIMIT);
+
+	// only one creature is gone from view
+	const uint32_t invisible = 0x40000000 + 777;
+	uint32_t evicted = knownCreatures.insert(0x40010000, [=](uint32_t id) { return id == invisible; });
+	BOOST_TEST(evicted == invisible);
+	BOOST_TEST(knownCreatures.size() == KnownCreatures::LIMIT);
+	BOOST_TEST(!knownCreatures.contains(invisible));
+	BOOST_TEST(knownCreatures.contains(0x40010000));
+
+	// every other creature survived the eviction and the shifting that came with it
+	for (uint32_t id = 1; id <= KnownCreatures::LIMIT; ++id) {
+		if (0x40000000 + id != invisible) {
+			BOOST_TEST(knownCreatures.contains(0x40000000 + id));
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_knowncreatures_evicts_even_if_all_visible)
+{
+	KnownCreatures knownCreatures;
+	for (uint32_t id = 1; id <= KnownCreatures::LIMIT; ++id) {
+		knownCreatures.insert(id, [](uint32_t) { return false; });
+	}
+
+	uint32_t evicted = knownCreatures.insert(0x10000000, [](uint32_t) { return false; });
+	BOOST_TEST(evicted != 0u);
+	BOOST_TEST(evicted != 0x10000000u);
+	BOOST_TEST(!knownCreatures.contains(evicted));
+	BOOST_TEST(knownCreatures.size() == KnownCreatures::LIMIT);
+}
+
+BOOST_AUTO_TEST_CASE(test_knowncreatures_matches_set)
+{
+	KnownCreatures knownCreatures;
+	std::unordered_set<uint32_t> expected;
+
+	std::mt19937 generator{42};
+	std::uniform_int_distribution<uint32_t> ids{0x10000000, 0x10000000 + 4000};
+	for (int i = 0; i < 100000; ++i) {
+		uint32_t id = ids(generator);
+		BOOST_TEST(knownCreatures.contains(id) == expected.contains(id));
+		if (!expected.contains(id)) {
+			uint32_t evicted = knownCreatures.insert(id, [&](uint32_t candidate) { return candidate % 3 == 0; });
+			if (evicted != 0) {
+				BOOST_TEST(expected.erase(evicted) == 1u);
+			}
+			expected.insert(id);
+		}
+		BOOST_TEST(knownCreatures.size() == expected.size());
+	}
+}
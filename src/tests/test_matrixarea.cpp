@@ -146,3 +146,29 @@ BOOST_AUTO_TEST_CASE(test_MatrixArea_rotate270)
 	BOOST_TEST(!m(3, 1));
 	BOOST_TEST(!m(3, 2));
 }
+
+BOOST_AUTO_TEST_CASE(test_MatrixArea_compileRowMasks)
+{
+	// clang-format off
+	auto m = createArea({
+        0, 0, 1, 1,
+        3, 1, 1, 1,
+        0, 0, 1, 1,
+    }, 3);
+	// clang-format on
+	m.compileRowMasks();
+
+	BOOST_TEST(m.getRowWords() == 1);
+	BOOST_TEST(m.getRowMask(0, 0) == 0b1100u);
+	BOOST_TEST(m.getRowMask(1, 0) == 0b1111u);
+	BOOST_TEST(m.getRowMask(2, 0) == 0b1100u);
+
+	auto r = m.rotate90();
+	r.compileRowMasks();
+
+	BOOST_TEST(r.getRowWords() == 1);
+	BOOST_TEST(r.getRowMask(0, 0) == 0b010u);
+	BOOST_TEST(r.getRowMask(1, 0) == 0b010u);
+	BOOST_TEST(r.getRowMask(2, 0) == 0b111u);
+	BOOST_TEST(r.getRowMask(3, 0) == 0b111u);
+}
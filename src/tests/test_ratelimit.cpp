@@ -0,0 +1,47 @@
+#define BOOST_TEST_MODULE ratelimit
+
+#include "../otpch.h"
+
+#include "../ratelimit.h"
+
+#include <boost/test/unit_test.hpp>
+
+using boost::asio::ip::make_address;
+
+BOOST_AUTO_TEST_CASE(test_ratelimit_allows_burst_then_refills)
+{
+	RateLimiter limiter{64};
+	auto address = make_address("192.168.0.1");
+
+	for (uint32_t i = 0; i < 3; ++i) {
+		BOOST_TEST(limiter.consume(address, 100, 3, 1000));
+	}
+	BOOST_TEST(!limiter.consume(address, 100, 3, 1000));
+	BOOST_TEST(!limiter.consume(address, 100, 3, 1099));
+
+	BOOST_TEST(limiter.consume(address, 100, 3, 1100));
+	BOOST_TEST(!limiter.consume(address, 100, 3, 1100));
+
+	// an idle bucket is full again
+	for (uint32_t i = 0; i < 3; ++i) {
+		BOOST_TEST(limiter.consume(address, 100, 3, 5000));
+	}
+	BOOST_TEST(!limiter.consume(address, 100, 3, 5000));
+}
+
+BOOST_AUTO_TEST_CASE(test_ratelimit_keys_by_address)
+{
+	RateLimiter limiter{1 << 16};
+
+	BOOST_TEST(limiter.consume(make_address("10.0.0.1"), 1000, 1, 0));
+	BOOST_TEST(!limiter.consume(make_address("10.0.0.1"), 1000, 1, 0));
+	BOOST_TEST(limiter.consume(make_address("10.0.0.2"), 1000, 1, 0));
+
+	// IPv4-mapped addresses share the bucket of the plain IPv4 address
+	BOOST_TEST(!limiter.consume(make_address("::ffff:10.0.0.1"), 1000, 1, 0));
+
+	// IPv6 addresses are limited per /64
+	BOOST_TEST(limiter.consume(make_address("2001:db8::1"), 1000, 1, 0));
+	BOOST_TEST(!limiter.consume(make_address("2001:db8::2"), 1000, 1, 0));
+	BOOST_TEST(limiter.consume(make_address("2001:db8:0:1::1"), 1000, 1, 0));
+}
@@ -25,6 +25,21 @@ struct PrivateKeyFixture
 	    "eb05++112fyvO85ABUun524z9lokKNFh45NKLjUCQGshzV43P+RioiBhtEpB/QFzijiS4L2HKNu1\n"
 	    "tdhudnUjWkaf6jJmQS/ppln0hhRMHlk9Vus/bPx7LtuDuo6VQDo=\n"
 	    "-----END RSA PRIVATE KEY-----\n";
+
+	// the public key can be extracted from the private key with the following command:
+	// $ openssl pkey -in key.pem -pubout
+
+	// the encrypted message was generated by encrypting 64 times the character 'x' (0x78) with the following command:
+	// $ head -c 128 < /dev/zero | tr '\0' 'x' | openssl pkeyutl -encrypt -inkey key.pem -pkeyopt rsa_padding_mode:none
+
+	// then interleave with \x for every byte (2 digits)
+	std::string_view encryptedMessage{
+	    "\x72\x17\x59\x03\xe4\xe9\xf8\x51\xce\x44\x0f\x83\x35\xbf\x65\xf0\x23\xe9\x80\xfc\x8c\x80\x43\x08\xa4\x0e\xd2\xc1\x1d\x7d"
+	    "\x03\x38\xb0\x3b\x0b\xb6\xd1\xf9\xf4\x55\xdc\x71\x12\xc2\x17\x92\xee\xd3\x22\xfa\xd4\x24\xd3\xd5\x05\x5d\x38\x34\xd4\x12"
+	    "\xdf\x3b\x0d\xc5\xa8\x59\xe5\x9d\x1f\x92\xb6\x3f\x54\x0a\xe0\x44\xeb\x6e\x55\x0a\x8e\xd0\xd1\xf7\x84\x1d\x3c\x0b\xcc\x3e"
+	    "\x2b\x08\x83\x3d\xa7\x83\x67\xb8\x3d\x49\xda\x13\xde\x41\x18\x7f\x42\xb2\x80\x8f\x9b\xe6\xfe\x4b\xb7\xe2\xab\x98\x0f\x4a"
+	    "\xdd\x52\xe9\xb1\x5b\xef\x25\x03",
+	    128};
 };
 
 struct Deleter
@@ -113,22 +128,39 @@ BOOST_FIXTURE_TEST_CASE(test_rsa_decrypt, PrivateKeyFixture)
 {
 	tfs::rsa::loadPEM(privateKey);
 
-	// the public key can be extracted from the private key with the following command:
-	// $ openssl pkey -in key.pem -pubout
-
-	// the encrypted message was generated by encrypting 64 times the character 'x' (0x78) with the following command:
-	// $ head -c 128 < /dev/zero | tr '\0' 'x' | openssl pkeyutl -encrypt -inkey key.pem -pkeyopt rsa_padding_mode:none
-
-	// then interleave with \x for every byte (2 digits)
-
 	std::string plaintext(128, 'x');
-	std::string encrypted =
-	    "\x72\x17\x59\x03\xe4\xe9\xf8\x51\xce\x44\x0f\x83\x35\xbf\x65\xf0\x23\xe9\x80\xfc\x8c\x80\x43\x08\xa4\x0e\xd2\xc1\x1d\x7d"
-	    "\x03\x38\xb0\x3b\x0b\xb6\xd1\xf9\xf4\x55\xdc\x71\x12\xc2\x17\x92\xee\xd3\x22\xfa\xd4\x24\xd3\xd5\x05\x5d\x38\x34\xd4\x12"
-	    "\xdf\x3b\x0d\xc5\xa8\x59\xe5\x9d\x1f\x92\xb6\x3f\x54\x0a\xe0\x44\xeb\x6e\x55\x0a\x8e\xd0\xd1\xf7\x84\x1d\x3c\x0b\xcc\x3e"
-	    "\x2b\x08\x83\x3d\xa7\x83\x67\xb8\x3d\x49\xda\x13\xde\x41\x18\x7f\x42\xb2\x80\x8f\x9b\xe6\xfe\x4b\xb7\xe2\xab\x98\x0f\x4a"
-	    "\xdd\x52\xe9\xb1\x5b\xef\x25\x03";
+	std::string encrypted{encryptedMessage};
 
 	tfs::rsa::decrypt(reinterpret_cast<uint8_t*>(encrypted.data()), encrypted.size());
 	BOOST_TEST(encrypted == plaintext, "expected '" << plaintext << "', got '" << encrypted << "'");
 }
+
+BOOST_FIXTURE_TEST_CASE(test_rsa_decrypt_async, PrivateKeyFixture)
+{
+	tfs::rsa::loadPEM(privateKey);
+	tfs::rsa::startWorkers();
+
+	std::string plaintext(128, 'x');
+	std::vector<std::string> messages(16, std::string{encryptedMessage});
+
+	std::mutex mutex;
+	std::condition_variable signal;
+	size_t decrypted = 0;
+	for (auto& message : messages) {
+		BOOST_TEST(tfs::rsa::decryptAsync(reinterpret_cast<uint8_t*>(message.data()), message.size(), [&]() {
+			std::lock_guard<std::mutex> lock(mutex);
+			++decrypted;
+			signal.notify_one();
+		}));
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		signal.wait(lock, [&]() { return decrypted == messages.size(); });
+	}
+	tfs::rsa::joinWorkers();
+
+	for (const auto& message : messages) {
+		BOOST_TEST(message == plaintext, "expected '" << plaintext << "', got '" << message << "'");
+	}
+}
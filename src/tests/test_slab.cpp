@@ -0,0 +1,80 @@
+#define BOOST_TEST_MODULE slab
+
+#include "../otpch.h"
+
+#include "../slab.h"
+
+#include <boost/test/unit_test.hpp>
+
+namespace {
+
+struct Pooled : SlabAllocated<Pooled>
+{
+	virtual ~Pooled() = default;
+	int64_t value = 0;
+};
+
+struct Larger : Pooled
+{
+	int64_t extra[4] = {};
+};
+
+struct SameLayout : SlabAllocated<SameLayout>
+{
+	virtual ~SameLayout() = default;
+	int64_t value = 0;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_slab_reuses_freed_slots)
+{
+	using TestSlab = Slab<24, 16, 4>;
+
+	void* a = TestSlab::allocate();
+	void* b = TestSlab::allocate();
+	BOOST_TEST(a != b);
+	BOOST_TEST(TestSlab::getLiveObjects() == 2);
+	BOOST_TEST(reinterpret_cast<uintptr_t>(b) % 16 == 0);
+
+	TestSlab::deallocate(a);
+	BOOST_TEST(TestSlab::getLiveObjects() == 1);
+	BOOST_TEST(TestSlab::allocate() == a);
+
+	// a fifth object needs a second chunk
+	for (int i = 0; i < 3; ++i) {
+		TestSlab::allocate();
+	}
+	BOOST_TEST(TestSlab::getLiveObjects() == 5);
+	BOOST_TEST(TestSlab::getReservedBytes() == 2 * 4 * 32);
+}
+
+BOOST_AUTO_TEST_CASE(test_slab_allocated_only_pools_exact_type)
+{
+	auto before = Pooled::getLiveObjects();
+
+	Pooled* pooled = new Pooled;
+	BOOST_TEST(Pooled::getLiveObjects() == before + 1);
+
+	Pooled* larger = new Larger;
+	BOOST_TEST(Pooled::getLiveObjects() == before + 1);
+
+	delete larger;
+	delete pooled;
+	BOOST_TEST(Pooled::getLiveObjects() == before);
+}
+
+BOOST_AUTO_TEST_CASE(test_slab_allocated_counts_per_type)
+{
+	static_assert(sizeof(Pooled) == sizeof(SameLayout) && alignof(Pooled) == alignof(SameLayout));
+
+	auto pooledBefore = Pooled::getLiveObjects();
+	auto sameLayoutBefore = SameLayout::getLiveObjects();
+
+	SameLayout* sameLayout = new SameLayout;
+	BOOST_TEST(Pooled::getLiveObjects() == pooledBefore);
+	BOOST_TEST(SameLayout::getLiveObjects() == sameLayoutBefore + 1);
+
+	delete sameLayout;
+	BOOST_TEST(SameLayout::getLiveObjects() == sameLayoutBefore);
+}
@@ -0,0 +1,96 @@
+#define BOOST_TEST_MODULE wildcardtree
+
+#include "../otpch.h"
+
+#include "../wildcardtree.h"
+
+#include <boost/test/unit_test.hpp>
+
+namespace {
+
+ReturnValue findOne(const WildcardTreeNode& tree, std::string_view query, std::string& result)
+{
+	result.clear();
+	return tree.findOne(query, result);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_wildcardtree_find_one)
+{
+	WildcardTreeNode tree{false};
+	tree.insert("alice");
+	tree.insert("alicia");
+	tree.insert("bob");
+
+	std::string result;
+	BOOST_TEST(findOne(tree, "b", result) == RETURNVALUE_NOERROR);
+	BOOST_TEST(result == "bob");
+
+	BOOST_TEST(findOne(tree, "bob", result) == RETURNVALUE_NOERROR);
+	BOOST_TEST(result == "bob");
+
+	BOOST_TEST(findOne(tree, "al", result) == RETURNVALUE_NAMEISTOOAMBIGUOUS);
+	BOOST_TEST(findOne(tree, "alic", result) == RETURNVALUE_NAMEISTOOAMBIGUOUS);
+
+	BOOST_TEST(findOne(tree, "alice", result) == RETURNVALUE_NOERROR);
+	BOOST_TEST(result == "alice");
+
+	BOOST_TEST(findOne(tree, "alicia", result) == RETURNVALUE_NOERROR);
+	BOOST_TEST(result == "alicia");
+
+	BOOST_TEST(findOne(tree, "c", result) == RETURNVALUE_PLAYERWITHTHISNAMEISNOTONLINE);
+	BOOST_TEST(findOne(tree, "alx", result) == RETURNVALUE_PLAYERWITHTHISNAMEISNOTONLINE);
+	BOOST_TEST(findOne(tree, "bobby", result) == RETURNVALUE_PLAYERWITHTHISNAMEISNOTONLINE);
+}
+
+BOOST_AUTO_TEST_CASE(test_wildcardtree_name_is_prefix_of_another)
+{
+	WildcardTreeNode tree{false};
+	tree.insert("tom");
+	tree.insert("tommy");
+
+	std::string result;
+	BOOST_TEST(findOne(tree, "to", result) == RETURNVALUE_NAMEISTOOAMBIGUOUS);
+	BOOST_TEST(findOne(tree, "tom", result) == RETURNVALUE_NAMEISTOOAMBIGUOUS);
+
+	BOOST_TEST(findOne(tree, "tomm", result) == RETURNVALUE_NOERROR);
+	BOOST_TEST(result == "tommy");
+
+	tree.remove("tommy");
+	BOOST_TEST(findOne(tree, "t", result) == RETURNVALUE_NOERROR);
+	BOOST_TEST(result == "tom");
+
+	tree.insert("tommy");
+	tree.remove("tom");
+	BOOST_TEST(findOne(tree, "t", result) == RETURNVALUE_NOERROR);
+	BOOST_TEST(result == "tommy");
+}
+
+BOOST_AUTO_TEST_CASE(test_wildcardtree_remove)
+{
+	WildcardTreeNode tree{false};
+	tree.insert("alice");
+	tree.insert("alicia");
+	tree.insert("bob");
+
+	// names that are not in the tree are ignored
+	tree.remove("ali");
+	tree.remove("alicex");
+	tree.remove("carol");
+
+	std::string result;
+	BOOST_TEST(findOne(tree, "alic", result) == RETURNVALUE_NAMEISTOOAMBIGUOUS);
+
+	tree.remove("alicia");
+	BOOST_TEST(findOne(tree, "a", result) == RETURNVALUE_NOERROR);
+	BOOST_TEST(result == "alice");
+	BOOST_TEST(findOne(tree, "alicia", result) == RETURNVALUE_PLAYERWITHTHISNAMEISNOTONLINE);
+
+	tree.remove("bob");
+	BOOST_TEST(findOne(tree, "", result) == RETURNVALUE_NOERROR);
+	BOOST_TEST(result == "alice");
+
+	tree.remove("alice");
+	BOOST_TEST(findOne(tree, "a", result) == RETURNVALUE_PLAYERWITHTHISNAMEISNOTONLINE);
+}
@@ -25,6 +25,28 @@ Tile& Tile::nullptr_tile = real_nullptr_tile;
 
 bool Tile::hasProperty(ITEMPROPERTY prop) const
 {
+	// these are kept up to date in the tile flags as items are added, removed and transformed
+	switch (prop) {
+		case CONST_PROP_BLOCKSOLID:
+			return hasFlag(TILESTATE_BLOCKSOLID);
+		case CONST_PROP_BLOCKPROJECTILE:
+			return hasFlag(TILESTATE_BLOCKPROJECTILE);
+		case CONST_PROP_BLOCKPATH:
+			return hasFlag(TILESTATE_BLOCKPATH);
+		case CONST_PROP_IMMOVABLEBLOCKSOLID:
+			return hasFlag(TILESTATE_IMMOVABLEBLOCKSOLID);
+		case CONST_PROP_IMMOVABLEBLOCKPATH:
+			return hasFlag(TILESTATE_IMMOVABLEBLOCKPATH);
+		case CONST_PROP_IMMOVABLENOFIELDBLOCKPATH:
+			return hasFlag(TILESTATE_IMMOVABLENOFIELDBLOCKPATH);
+		case CONST_PROP_NOFIELDBLOCKPATH:
+			return hasFlag(TILESTATE_NOFIELDBLOCKPATH);
+		case CONST_PROP_SUPPORTHANGABLE:
+			return hasFlag(TILESTATE_SUPPORTS_HANGABLE);
+		default:
+			break;
+	}
+
 	if (ground && ground->hasProperty(prop)) {
 		return true;
 	}
@@ -347,6 +369,8 @@ Thing* Tile::getTopVisibleThing(const Creature* creature)
 
 void Tile::onAddTileItem(Item* item)
 {
+	bumpVersion();
+
 	if (item->hasProperty(CONST_PROP_MOVEABLE) || item->getContainer()) {
 		auto it = g_game.browseFields.find(this);
 		if (it != g_game.browseFields.end()) {
@@ -377,6 +401,8 @@ void Tile::onAddTileItem(Item* item)
 
 void Tile::onUpdateTileItem(Item* oldItem, const ItemType& oldType, Item* newItem, const ItemType& newType)
 {
+	bumpVersion();
+
 	if (newItem->hasProperty(CONST_PROP_MOVEABLE) || newItem->getContainer()) {
 		auto it = g_game.browseFields.find(this);
 		if (it != g_game.browseFields.end()) {
@@ -413,6 +439,8 @@ void Tile::onUpdateTileItem(Item* oldItem, const ItemType& oldType, Item* newIte
 
 void Tile::onRemoveTileItem(const SpectatorVec& spectators, const std::vector<int32_t>& oldStackPosVector, Item* item)
 {
+	bumpVersion();
+
 	if (item->hasProperty(CONST_PROP_MOVEABLE) || item->getContainer()) {
 		auto it = g_game.browseFields.find(this);
 		if (it != g_game.browseFields.end()) {
@@ -597,17 +625,13 @@ ReturnValue Tile::queryAdd(int32_t, const Thing& thing, uint32_t, uint32_t flags
 			}
 		} else {
 			// FLAG_IGNOREBLOCKITEM is set
-			if (ground) {
-				const ItemType& iiType = Item::items[ground->getID()];
-				if (iiType.blockSolid && (!iiType.moveable || ground->hasAttribute(ITEM_ATTRIBUTE_UNIQUEID))) {
-					return RETURNVALUE_NOTPOSSIBLE;
-				}
+			if (ground && ground->hasProperty(CONST_PROP_IMMOVABLEBLOCKSOLID)) {
+				return RETURNVALUE_NOTPOSSIBLE;
 			}
 
 			if (const auto items = getItemList()) {
 				for (const Item* item : *items) {
-					const ItemType& iiType = Item::items[item->getID()];
-					if (iiType.blockSolid && (!iiType.moveable || item->hasAttribute(ITEM_ATTRIBUTE_UNIQUEID))) {
+					if (item->hasProperty(CONST_PROP_IMMOVABLEBLOCKSOLID)) {
 						return RETURNVALUE_NOTPOSSIBLE;
 					}
 				}
@@ -650,28 +674,26 @@ ReturnValue Tile::queryAdd(int32_t, const Thing& thing, uint32_t, uint32_t flags
 				}
 			}
 		} else {
-			if (ground) {
+			if (ground && ground->hasProperty(CONST_PROP_BLOCKSOLID)) {
 				const ItemType& iiType = Item::items[ground->getID()];
-				if (iiType.blockSolid) {
-					if (!iiType.allowPickupable || item->isMagicField() || item->isBlocking()) {
-						if (!item->isPickupable()) {
-							return RETURNVALUE_NOTENOUGHROOM;
-						}
+				if (!iiType.allowPickupable || item->isMagicField() || item->isBlocking()) {
+					if (!item->isPickupable()) {
+						return RETURNVALUE_NOTENOUGHROOM;
+					}
 
-						if (!iiType.hasHeight || iiType.pickupable || iiType.isBed()) {
-							return RETURNVALUE_NOTENOUGHROOM;
-						}
+					if (!iiType.hasHeight || iiType.pickupable || iiType.isBed()) {
+						return RETURNVALUE_NOTENOUGHROOM;
 					}
 				}
 			}
 
 			if (items) {
 				for (const Item* tileItem : *items) {
-					const ItemType& iiType = Item::items[tileItem->getID()];
-					if (!iiType.blockSolid) {
+					if (!tileItem->hasProperty(CONST_PROP_BLOCKSOLID)) {
 						continue;
 					}
 
+					const ItemType& iiType = Item::items[tileItem->getID()];
 					if (iiType.allowPickupable && !item->isMagicField() && !item->isBlocking()) {
 						continue;
 					}
@@ -1056,6 +1078,7 @@ void Tile::removeThing(Thing* thing, uint32_t count)
 	}
 
 	if (item == ground) {
+		resetTileFlags(item);
 		ground->setParent(nullptr);
 		ground = nullptr;
 
@@ -1420,6 +1443,8 @@ void Tile::internalAddThing(uint32_t, Thing* thing)
 			return;
 		}
 
+		bumpVersion();
+
 		const ItemType& itemType = Item::items[item->getID()];
 		if (itemType.isGroundTile()) {
 			if (!ground) {
@@ -1473,6 +1498,14 @@ void Tile::setTileFlags(const Item* item)
 		setFlag(TILESTATE_BLOCKPATH);
 	}
 
+	if (item->hasProperty(CONST_PROP_IMMOVABLEBLOCKPATH)) {
+		setFlag(TILESTATE_IMMOVABLEBLOCKPATH);
+	}
+
+	if (item->hasProperty(CONST_PROP_BLOCKPROJECTILE)) {
+		setFlag(TILESTATE_BLOCKPROJECTILE);
+	}
+
 	if (item->hasProperty(CONST_PROP_NOFIELDBLOCKPATH)) {
 		setFlag(TILESTATE_NOFIELDBLOCKPATH);
 	}
@@ -1534,6 +1567,10 @@ void Tile::resetTileFlags(const Item* item)
 		resetFlag(TILESTATE_BLOCKPATH);
 	}
 
+	if (item->hasProperty(CONST_PROP_BLOCKPROJECTILE) && !hasProperty(item, CONST_PROP_BLOCKPROJECTILE)) {
+		resetFlag(TILESTATE_BLOCKPROJECTILE);
+	}
+
 	if (item->hasProperty(CONST_PROP_NOFIELDBLOCKPATH) && !hasProperty(item, CONST_PROP_NOFIELDBLOCKPATH)) {
 		resetFlag(TILESTATE_NOFIELDBLOCKPATH);
 	}
@@ -1572,7 +1609,7 @@ void Tile::resetTileFlags(const Item* item)
 		resetFlag(TILESTATE_DEPOT);
 	}
 
-	if (item->hasProperty(CONST_PROP_SUPPORTHANGABLE)) {
+	if (item->hasProperty(CONST_PROP_SUPPORTHANGABLE) && !hasProperty(item, CONST_PROP_SUPPORTHANGABLE)) {
 		resetFlag(TILESTATE_SUPPORTS_HANGABLE);
 	}
 }
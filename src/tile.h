@@ -47,6 +47,7 @@ enum tileflags_t : uint32_t
 	TILESTATE_IMMOVABLENOFIELDBLOCKPATH = 1 << 21,
 	TILESTATE_NOFIELDBLOCKPATH = 1 << 22,
 	TILESTATE_SUPPORTS_HANGABLE = 1 << 23,
+	TILESTATE_BLOCKPROJECTILE = 1 << 24,
 
 	TILESTATE_FLOORCHANGE = TILESTATE_FLOORCHANGE_DOWN | TILESTATE_FLOORCHANGE_NORTH | TILESTATE_FLOORCHANGE_SOUTH |
 	                        TILESTATE_FLOORCHANGE_EAST | TILESTATE_FLOORCHANGE_WEST | TILESTATE_FLOORCHANGE_SOUTH_ALT |
@@ -241,7 +242,14 @@ public:
 	Item* getUseItem(int32_t index) const;
 
 	Item* getGround() const { return ground; }
-	void setGround(Item* item) { ground = item; }
+	void setGround(Item* item)
+	{
+		ground = item;
+		bumpVersion();
+	}
+
+	// changes whenever spectators are told about an item being added, updated or removed
+	uint32_t getVersion() const { return version; }
 
 private:
 	void onAddTileItem(Item* item);
@@ -251,14 +259,20 @@ private:
 	void setTileFlags(const Item* item);
 	void resetTileFlags(const Item* item);
 
+	void bumpVersion() { version = ++lastVersion; }
+
 	Item* ground = nullptr;
 	Position tilePos;
 	uint32_t flags = 0;
+	uint32_t version = ++lastVersion;
+
+	// shared by all tiles, so that a tile reusing the memory of a destroyed one never repeats its versions
+	static inline uint32_t lastVersion = 0;
 };
 
 // Used for walkable tiles, where there is high likeliness of
 // items being added/removed
-class DynamicTile : public Tile
+class DynamicTile : public Tile, public SlabAllocated<DynamicTile>
 {
 	// By allocating the vectors in-house, we avoid some memory fragmentation
 	TileItemVector items;
@@ -287,7 +301,7 @@ public:
 };
 
 // For blocking tiles, where we very rarely actually have items
-class StaticTile final : public Tile
+class StaticTile final : public Tile, public SlabAllocated<StaticTile>
 {
 	// We very rarely even need the vectors, so don't keep them in memory
 	std::unique_ptr<TileItemVector> items;
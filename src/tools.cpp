@@ -145,6 +145,23 @@ bool caseInsensitiveStartsWith(std::string_view str, std::string_view prefix)
 	                                                 [](char a, char b) { return tolower(a) == tolower(b); });
 }
 
+bool CaseInsensitiveLess::operator()(std::string_view str1, std::string_view str2) const
+{
+	return std::lexicographical_compare(str1.begin(), str1.end(), str2.begin(), str2.end(),
+	                                    [](char a, char b) { return tolower(a) < tolower(b); });
+}
+
+size_t CaseInsensitiveHash::operator()(std::string_view str) const
+{
+	// FNV-1a over the lowercased characters
+	uint64_t hash = 14695981039346656037ull;
+	for (char c : str) {
+		hash ^= static_cast<uint8_t>(tolower(c));
+		hash *= 1099511628211ull;
+	}
+	return static_cast<size_t>(hash);
+}
+
 std::vector<std::string_view> explodeString(std::string_view inString, const std::string& separator,
                                             int32_t limit /* = -1*/)
 {
@@ -20,6 +20,26 @@ bool caseInsensitiveEqual(std::string_view str1, std::string_view str2);
 // checks that str1 starts with str2 ignoring letter case
 bool caseInsensitiveStartsWith(std::string_view str, std::string_view prefix);
 
+// comparators for containers keyed by names that ignore letter case; they are transparent, so a lookup can be done
+// with any string (view) without building a lowercase copy of it first
+struct CaseInsensitiveLess
+{
+	using is_transparent = void;
+	bool operator()(std::string_view str1, std::string_view str2) const;
+};
+
+struct CaseInsensitiveHash
+{
+	using is_transparent = void;
+	size_t operator()(std::string_view str) const;
+};
+
+struct CaseInsensitiveEqual
+{
+	using is_transparent = void;
+	bool operator()(std::string_view str1, std::string_view str2) const { return caseInsensitiveEqual(str1, str2); }
+};
+
 using StringVector = std::vector<std::string>;
 using IntegerVector = std::vector<int32_t>;
 
@@ -5,99 +5,113 @@
 
 #include "wildcardtree.h"
 
-#include <stack>
-#include <tuple>
-
-WildcardTreeNode* WildcardTreeNode::getChild(char ch)
+std::vector<WildcardTreeNode>::iterator WildcardTreeNode::findChild(char ch)
 {
-	auto it = children.find(ch);
-	if (it == children.end()) {
-		return nullptr;
-	}
-	return &it->second;
+	return std::lower_bound(children.begin(), children.end(), ch,
+	                        [](const WildcardTreeNode& node, char ch) { return node.label.front() < ch; });
 }
 
-const WildcardTreeNode* WildcardTreeNode::getChild(char ch) const
+std::vector<WildcardTreeNode>::const_iterator WildcardTreeNode::findChild(char ch) const
 {
-	auto it = children.find(ch);
-	if (it == children.end()) {
-		return nullptr;
-	}
-	return &it->second;
+	return std::lower_bound(children.begin(), children.end(), ch,
+	                        [](const WildcardTreeNode& node, char ch) { return node.label.front() < ch; });
 }
 
-WildcardTreeNode* WildcardTreeNode::addChild(char ch, bool breakpoint)
+void WildcardTreeNode::mergeWithChild()
 {
-	WildcardTreeNode* child = getChild(ch);
-	if (child) {
-		if (breakpoint && !child->breakpoint) {
-			child->breakpoint = true;
-		}
-	} else {
-		auto pair =
-		    children.emplace(std::piecewise_construct, std::forward_as_tuple(ch), std::forward_as_tuple(breakpoint));
-		child = &pair.first->second;
-	}
-	return child;
+	WildcardTreeNode child = std::move(children.front());
+	label += child.label;
+	breakpoint = child.breakpoint;
+	children = std::move(child.children);
 }
 
-void WildcardTreeNode::insert(const std::string& str)
+void WildcardTreeNode::insert(std::string_view str)
 {
 	WildcardTreeNode* cur = this;
+	while (!str.empty()) {
+		auto it = cur->findChild(str.front());
+		if (it == cur->children.end() || it->label.front() != str.front()) {
+			it = cur->children.emplace(it, true);
+			it->label = str;
+			return;
+		}
 
-	size_t length = str.length() - 1;
-	for (size_t pos = 0; pos < length; ++pos) {
-		cur = cur->addChild(str[pos], false);
+		auto [labelEnd, strEnd] = std::mismatch(it->label.begin(), it->label.end(), str.begin(), str.end());
+		size_t common = labelEnd - it->label.begin();
+		if (common < it->label.size()) {
+			// str leaves this node's label halfway, split it there
+			WildcardTreeNode tail(it->breakpoint);
+			tail.label = it->label.substr(common);
+			tail.children = std::move(it->children);
+
+			it->label.resize(common);
+			it->breakpoint = false;
+			it->children.clear();
+			it->children.push_back(std::move(tail));
+		}
+
+		str.remove_prefix(common);
+		cur = &*it;
 	}
 
-	cur->addChild(str[length], true);
+	cur->breakpoint = true;
 }
 
-void WildcardTreeNode::remove(const std::string& str)
+void WildcardTreeNode::remove(std::string_view str)
 {
+	WildcardTreeNode* parent = nullptr;
+	WildcardTreeNode* grandparent = nullptr;
 	WildcardTreeNode* cur = this;
-
-	std::stack<WildcardTreeNode*> path;
-	path.push(cur);
-	size_t len = str.length();
-	for (size_t pos = 0; pos < len; ++pos) {
-		cur = cur->getChild(str[pos]);
-		if (!cur) {
+	while (!str.empty()) {
+		auto it = cur->findChild(str.front());
+		if (it == cur->children.end() || !str.starts_with(it->label)) {
 			return;
 		}
-		path.push(cur);
+
+		str.remove_prefix(it->label.size());
+		grandparent = parent;
+		parent = cur;
+		cur = &*it;
 	}
 
 	cur->breakpoint = false;
+	if (!parent) {
+		return;
+	}
 
-	do {
-		cur = path.top();
-		path.pop();
-
-		if (!cur->children.empty() || cur->breakpoint || path.empty()) {
-			break;
-		}
-
-		cur = path.top();
+	if (cur->children.empty()) {
+		parent->children.erase(parent->findChild(cur->label.front()));
 
-		auto it = cur->children.find(str[--len]);
-		if (it != cur->children.end()) {
-			cur->children.erase(it);
+		// the parent may have been left with a single child, the root is never merged
+		if (grandparent && !parent->breakpoint && parent->children.size() == 1) {
+			parent->mergeWithChild();
 		}
-	} while (true);
+	} else if (cur->children.size() == 1) {
+		cur->mergeWithChild();
+	}
 }
 
-ReturnValue WildcardTreeNode::findOne(const std::string& query, std::string& result) const
+ReturnValue WildcardTreeNode::findOne(std::string_view query, std::string& result) const
 {
+	result = query;
+
 	const WildcardTreeNode* cur = this;
-	for (char pos : query) {
-		cur = cur->getChild(pos);
-		if (!cur) {
+	while (!query.empty()) {
+		auto it = cur->findChild(query.front());
+		if (it == cur->children.end()) {
 			return RETURNVALUE_PLAYERWITHTHISNAMEISNOTONLINE;
 		}
-	}
 
-	result = query;
+		size_t length = std::min(query.size(), it->label.size());
+		if (query.compare(0, length, it->label, 0, length) != 0) {
+			return RETURNVALUE_PLAYERWITHTHISNAMEISNOTONLINE;
+		}
+
+		// the query may end halfway through the label, complete it
+		result.append(it->label, length);
+		query.remove_prefix(length);
+		cur = &*it;
+	}
 
 	do {
 		size_t size = cur->children.size();
@@ -107,8 +121,7 @@ ReturnValue WildcardTreeNode::findOne(const std::string& query, std::string& res
 			return RETURNVALUE_NAMEISTOOAMBIGUOUS;
 		}
 
-		auto it = cur->children.begin();
-		result += it->first;
-		cur = &it->second;
+		cur = &cur->children.front();
+		result += cur->label;
 	} while (true);
 }
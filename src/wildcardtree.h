@@ -6,27 +6,34 @@
 
 #include "enums.h"
 
+/*
+ * Radix tree of the names of online players, used to complete a name from a prefix. Each node holds the run of
+ * characters leading to it from its parent and its children sorted by their first character. Except for the root,
+ * every node either ends a name or branches into at least two children.
+ */
 class WildcardTreeNode
 {
 public:
 	explicit WildcardTreeNode(bool breakpoint) : breakpoint(breakpoint) {}
 	WildcardTreeNode(WildcardTreeNode&& other) = default;
+	WildcardTreeNode& operator=(WildcardTreeNode&& other) = default;
 
 	// non-copyable
 	WildcardTreeNode(const WildcardTreeNode&) = delete;
 	WildcardTreeNode& operator=(const WildcardTreeNode&) = delete;
 
-	WildcardTreeNode* getChild(char ch);
-	const WildcardTreeNode* getChild(char ch) const;
-	WildcardTreeNode* addChild(char ch, bool breakpoint);
+	void insert(std::string_view str);
+	void remove(std::string_view str);
 
-	void insert(const std::string& str);
-	void remove(const std::string& str);
-
-	ReturnValue findOne(const std::string& query, std::string& result) const;
+	ReturnValue findOne(std::string_view query, std::string& result) const;
 
 private:
-	std::map<char, WildcardTreeNode> children;
+	std::vector<WildcardTreeNode>::iterator findChild(char ch);
+	std::vector<WildcardTreeNode>::const_iterator findChild(char ch) const;
+	void mergeWithChild();
+
+	std::string label;
+	std::vector<WildcardTreeNode> children;
 	bool breakpoint;
 };
 